@@ -0,0 +1,76 @@
+// bag_randomizer.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/15/2025
+
+// 7-bag piece generator: every run of seven pieces holds each piece type
+// once, in an order drawn from a 32-bit Galois LFSR (x^32 + x^22 + x^2 +
+// x + 1). piece is always ready; take removes it from the bag and steps
+// the LFSR 16 bits so consecutive draws use fresh bits. The bag refills
+// when its last piece is taken.
+//
+// seed_valid reloads the LFSR and starts a new bag, so a seed gives the
+// same sequence every time. A zero seed would lock the LFSR and is
+// replaced by DEFAULT_SEED, which is also used out of reset.
+
+module bag_randomizer #(
+    parameter logic [31:0] DEFAULT_SEED = 32'h1D87_2B41
+) (
+    input  logic                        clk,
+    input  logic                        reset,
+
+    input  logic [31:0]                 seed,
+    input  logic                        seed_valid,
+
+    output tetris_pkg::piece_type_t     piece,
+    input  logic                        take
+);
+
+    localparam logic [31:0] TAPS = 32'h8020_0003;
+    localparam int          STEP = 16;
+
+    logic [31:0]    lfsr, lfsr_next;
+    logic [6:0]     bag;            // piece types still in this bag
+    logic [2:0]     bag_count;
+    logic [2:0]     pick;           // index among the pieces left
+
+    always_comb begin
+        lfsr_next = lfsr;
+        for (int i = 0; i < STEP; i++) begin
+            lfsr_next = lfsr_next[0] ? ((lfsr_next >> 1) ^ TAPS) : (lfsr_next >> 1);
+        end
+    end
+
+    // Scale 16 random bits to 0..bag_count-1, then find that set bit
+    always_comb begin
+        int seen;
+
+        bag_count = '0;
+        for (int i = 0; i < 7; i++) bag_count += 3'(bag[i]);
+
+        pick = 3'((19'(lfsr[15:0]) * bag_count) >> 16);
+
+        piece = tetris_pkg::piece_type_t'(3'd0);
+        seen  = 0;
+        for (int i = 0; i < 7; i++) begin
+            if (bag[i]) begin
+                if (seen == pick) piece = tetris_pkg::piece_type_t'(3'(i));
+                seen++;
+            end
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            lfsr <= DEFAULT_SEED;
+            bag  <= '1;
+        end else if (seed_valid) begin
+            lfsr <= (seed == '0) ? DEFAULT_SEED : seed;
+            bag  <= '1;
+        end else if (take) begin
+            lfsr <= lfsr_next;
+            bag  <= ((bag & ~(7'b1 << piece)) == '0) ? '1 : (bag & ~(7'b1 << piece));
+        end
+    end
+
+endmodule
@@ -16,15 +16,38 @@ module game_executioner #(
 )(
         input   logic                               reset,
         input   logic                               clk,
-        input   logic                               move_clk,
-        input   logic                               move_valid,
-        input   logic                               game_clk,
+        input   logic                               move_valid,     // command waiting at the command_fifo head
+        input   logic                               hard_drop,      // that command is a hard drop, not a move
+        input   logic                               hold,           // that command swaps with the hold slot
+        output  logic                               move_taken,     // command applied (or blocked) this cycle, pop it
+        input   logic                               game_tick,      // one-cycle gravity enable
+        input   logic                               gravity_20g,    // that tick drops to the landing row
+        input   logic                               frame_tick,     // one-cycle strobe per VGA frame (lock delay)
+
+        // OP_CONFIG writes (lock delay registers)
+        input   logic [7:0]                         config_addr,
+        input   logic [7:0]                         config_data,
+        input   logic                               config_we,
 
         input   tetris_pkg::command_t               move,
-        input   tetris_pkg::active_piece_t          new_piece,
+        input   tetris_pkg::active_piece_t          new_piece,      // head of the next-piece queue
+        input   logic                               new_piece_valid,
+        output  logic                               new_piece_taken,    // pop the queue
 
         output  game_state_pkg::game_state_t        GAME_state,
 
+        // Status for the MCU
+        output  game_state_pkg::bitboard_t          GAME_fixed_state,
+        output  tetris_pkg::active_piece_t          active_piece,
+        output  logic [15:0]                        lines_cleared,
+        output  logic [2:0]                         clear_count,    // rows removed by the last lock (for scoring)
+        output  logic                               clear_valid,    // one-cycle strobe with clear_count
+        output  logic [7:0]                         game_over_count,
+        output  logic                               game_over,      // one-cycle strobe per game over
+        output  logic [4:0]                         column_top [BOARD_WIDTH],   // skyline: top filled row per column, 20 if empty
+        output  tetris_pkg::piece_type_t            hold_piece,
+        output  logic                               hold_valid,
+
         // 6 debug windows, each 3-color 6x6
         output  logic [5:0]                         debug_window_0 [`COLORS][5:0],
         output  logic [5:0]                         debug_window_1 [`COLORS][5:0],
@@ -50,14 +73,15 @@ module game_executioner #(
     logic active_piece_toutching_bottom;
     logic active_piece_toutching_left;
     logic active_piece_toutching_right;
-    logic rotation_blocked;
+    logic window_rotation_collision;
     logic clearing_line;
     logic no_piece;
-
-    tetris_pkg::active_piece_t      active_piece;
+    logic window_down_collision;
 
     tetris_pkg::active_piece_grid_t active_piece_grid;
-    game_state_pkg::game_state_t    GAME_fixed_state;
+
+    // Fixed board with the active piece drawn in (row-major, see game_state_pkg)
+    game_state_pkg::bitboard_t GAME_board;
 
 
     piece_collision_checker Piece_Collision_Checker(
@@ -68,8 +92,8 @@ module game_executioner #(
         .piece_grid(active_piece_grid.piece),
         .left_collision(active_piece_toutching_left),
         .right_collision(active_piece_toutching_right),
-        .down_collision(active_piece_toutching_bottom),
-        .rotation_collision(rotation_blocked),
+        .down_collision(window_down_collision),     // debug only, landing_finder decides
+        .rotation_collision(window_rotation_collision),    // debug only, srs_kick decides
         .debug_window_0,
         .debug_window_1,
         .debug_window_2,
@@ -86,148 +110,215 @@ module game_executioner #(
         .debug_singals_5()
     );
 
-    flopR_2clk #(.WIDTH(1), .RESET(1)) No_Piece_flop(.clk_tree(clk), .target_clk(game_clk), .reset, .D(active_piece_toutching_bottom), .Q(no_piece));
+    // A landed piece locks when its lock delay runs out, or on the clk after
+    // a hard drop (lock_now). The board only changes on a lock, and the next
+    // piece spawns on the clk after it.
+    logic       hard_drop_applied;
+    logic       lock_now;
+    logic       lock_expired;
+    logic       move_applied;
+    logic       lock_step;
+    logic       spawn;
+    logic [$clog2(BOARD_HEIGHT+4)-1:0] drop_rows;
+
+    // Hold: swap the active piece for the held one (or the queue head),
+    // at most once per spawned piece
+    logic       hold_applied;
+    logic       hold_used;
+    logic       hold_waiting;   // empty hold slot and empty queue (e.g. after a flush)
+
+    // Clockwise rotation, placed at the first free SRS kick offset
+    logic       rotate_applied;
+    logic       kick_ok;
+    logic [3:0] kick_x;
+    logic [4:0] kick_y;
+
+    assign lock_step = active_piece_toutching_bottom & (lock_now | lock_expired);
+
+    always_ff @(posedge clk) begin
+        if (reset) lock_now <= 1'b0;
+        else       lock_now <= hard_drop_applied;
+    end
+
+    // Everything below runs on clk; the board only updates on lock_step
+    always_ff @(posedge clk) begin
+        if (reset)          no_piece <= 1'b1;
+        else if (lock_step) no_piece <= 1'b1;
+        else if (spawn)     no_piece <= 1'b0;
+    end
 
     // a piece is floating when the active piece is not toutching, unless clearing (no piece is active at this time)
-    flopRF_2clk #(.WIDTH(1)) Floating_Piece(.clk_tree(clk), .target_clk(game_clk), .reset, .flush(active_piece_toutching_bottom), .D(1'b1), .Q(floating_piece));
+    flopRFS #(.WIDTH(1)) Floating_Piece(.clk, .reset, .stall(~lock_step), .flush(active_piece_toutching_bottom), .D(1'b1), .Q(floating_piece));
 
-    // a new piece is asserted when the line isnt being cleared and thee isnt a floating piece the frame before, once you insert a new piece, you no longer insert a new piece
+    // a new piece is asserted when there isnt a floating piece the frame before, once you insert a new piece, you no longer insert a new piece
     assign insert_new_piece = no_piece;
 
-    flopRFS_2clk #(.WIDTH(5)) Gravity(.clk_tree(clk), .target_clk(game_clk), .reset, .flush(insert_new_piece | clearing_line), .stall(active_piece_toutching_bottom), 
-                                .D(active_piece.y + 1), .Q(active_piece.y));
+    // The queue head enters the board whole (type, x, y, rotation) in one
+    // cycle, on the clk after a lock
+    assign spawn = insert_new_piece & new_piece_valid;
+
+    // A move or rotation and a gravity step were each checked against the
+    // current position only, so a gravity tick that meets one is owed and
+    // taken on the next cycle without a move
+    logic gravity_step;
+    logic gravity_owed;
+
+    assign gravity_step = game_tick | gravity_owed;
+
+    always_ff @(posedge clk) begin
+        if (reset | spawn | hold_applied)   gravity_owed <= 1'b0;
+        else                                gravity_owed <= gravity_step & move_applied;
+    end
+
+    // Gravity moves the piece one row per tick (all the way at 20G); a hard
+    // drop moves it straight to its landing row.
+    always_ff @(posedge clk) begin
+        if (reset)                                              active_piece.y <= '0;
+        else if (spawn)                                         active_piece.y <= new_piece.y;
+        else if (hard_drop_applied)                             active_piece.y <= active_piece.y + drop_rows;
+        else if (hold_applied)                                  active_piece.y <= new_piece.y;
+        else if (rotate_applied)                                active_piece.y <= kick_y;
+        else if (gravity_step & ~move_applied & ~active_piece_toutching_bottom)
+                                                                active_piece.y <= gravity_20g ? active_piece.y + drop_rows :
+                                                                                                active_piece.y + 1;
+    end
 
     piece_decoder Piece_Decoder(.active_piece, .active_piece_grid);
 
-    // Next-state for the fixed board and line-clear flag
-    logic                         row_full      [BOARD_HEIGHT];
-    logic                         any_full_row;
-    int                           clear_y;          // index of bottom-most full row
-    logic                         clearing_line_next;
-    game_state_pkg::game_state_t  fixed_state_next;
+    // Clockwise rotation: decode the next orientation and try the SRS kicks
+    tetris_pkg::active_piece_t      rotated_piece;
+    tetris_pkg::active_piece_grid_t rotated_piece_grid;
+    tetris_pkg::rotation_t          next_rotation;
+
+    assign next_rotation = tetris_pkg::rotation_t'(active_piece.rotation + 2'd1);
 
-    // Combinational "next" logic for line clear
     always_comb begin
-        logic full;
-        // 1) Compute which rows are full (AND across x)
-        for (int y = 0; y < BOARD_HEIGHT; y++) begin
-            full = 1'b1;
-            for (int x = 0; x < BOARD_WIDTH; x++) begin
-                full &= GAME_fixed_state.screen[x][y];
-            end
-            row_full[y] = full;
-        end
+        rotated_piece          = active_piece;
+        rotated_piece.rotation = next_rotation;
+    end
 
-        // 2) Find bottom-most full row (if any)
-        any_full_row = 1'b0;
-        clear_y      = 0;
-        for (int y = 0; y < BOARD_HEIGHT; y++) begin
-            if (row_full[y]) begin
-                any_full_row = 1'b1; // keep true once set
-                clear_y      = y;                  // last one wins => bottom-most
-            end
-        end
+    piece_decoder Rotated_Piece_Decoder(.active_piece(rotated_piece), .active_piece_grid(rotated_piece_grid));
 
-        clearing_line_next    = 1'b0;
-        // 4) If we found a full row, clear *one* line (bottom-most) and
-        //    shift everything above it down by 1. Rows below are unchanged.
-        if (any_full_row) begin
-            clearing_line_next = 1'b1;
-        end
+    srs_kick Srs_Kick(.board(GAME_fixed_state), .piece_type(active_piece.piece_type), .rotation(active_piece.rotation),
+        .rotated_piece(rotated_piece_grid.piece), .piece_x(active_piece.x), .piece_y(active_piece.y),
+        .kick_ok, .kick_x, .kick_y);
 
-        if (clearing_line) begin
-            for (int y = 0; y < BOARD_HEIGHT; y++) begin
-                for (int x = 0; x < BOARD_WIDTH; x++) begin
-                    if (y == 0 && y <= clear_y) begin
-                        // Top row becomes empty whenever we clear a row
-                        fixed_state_next.screen[x][y] = 1'b0;
-                    end else if (y <= clear_y) begin
-                        // Rows 1..clear_y each take the row directly above
-                        fixed_state_next.screen[x][y] = GAME_fixed_state.screen[x][y-1];
-                    end else begin
-                        // Rows below the cleared line (y > clear_y) stay the same
-                        fixed_state_next.screen[x][y] = GAME_fixed_state.screen[x][y];
-                    end
-                end
+    landing_finder Landing_Finder(.board(GAME_fixed_state), .top_row(column_top), .active_piece_grid, .drop_rows);
+
+    // Resting on the board or the floor
+    assign active_piece_toutching_bottom = ~no_piece & (drop_rows == 0);
+
+    lock_delay Lock_Delay(.clk, .reset, .frame_tick, .landed(active_piece_toutching_bottom), .moved(move_applied),
+        .spawn(spawn | hold_applied),
+        .config_addr, .config_data, .config_we, .lock(lock_expired));
+
+    // Next-state for the fixed board: a lock writes the piece in and removes
+    // every row it completes in the same step
+    game_state_pkg::bitboard_t    locked_state;
+    logic [$clog2(BOARD_HEIGHT+1)-1:0] locked_clear_count;
+    game_state_pkg::bitboard_t    fixed_state_next;
+
+    row_compactor Row_Compactor(.in_state(GAME_board), .out_state(locked_state), .cleared_count(locked_clear_count));
+
+    always_comb begin
+        clearing_line = 1'b0;
+        GAME_OVER     = 1'b0;
+
+        if (active_piece_toutching_bottom) begin
+            if (GAME_board.rows == GAME_fixed_state.rows) begin
+                GAME_OVER             = 1'b1;
+                fixed_state_next.rows = game_state_pkg::blank_bitboard.rows;
+            end else begin
+                clearing_line         = (locked_clear_count != 0);
+                fixed_state_next.rows = locked_state.rows;
             end
-            GAME_OVER = 1'b0;
         end else begin
-             // 3) Default: just lock the board as-is, no clear
-             if (active_piece_toutching_bottom & ~clearing_line_next) begin
-                
-                if (GAME_state.screen == GAME_fixed_state.screen) begin
-                    GAME_OVER = 1'b1;
-                    fixed_state_next.screen      =  game_state_pkg::blank_game_state.screen;
-                end else begin
-                    GAME_OVER = 1'b0;
-                    fixed_state_next.screen      =  GAME_state.screen;
-                end
-             end else begin
-                fixed_state_next.screen      =  GAME_fixed_state.screen;
-                GAME_OVER = 1'b0;
-             end
+            fixed_state_next.rows = GAME_fixed_state.rows;
         end
     end
 
-    // clearing_line should be declared as a reg/logic somewhere:
-    // output logic clearing_line;
+    skyline Skyline(.clk, .reset,
+        .lock(lock_step & ~GAME_OVER), .clear(clearing_line), .wipe(lock_step & GAME_OVER),
+        .active_piece_grid, .cleared_board(locked_state), .top_row(column_top));
 
-    // Single flop updated with either a pure lock or the cleared version
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            GAME_fixed_state.rows   <= game_state_pkg::blank_bitboard.rows;
+            lines_cleared           <= '0;
+            game_over_count         <= '0;
+            clear_count             <= '0;
+            clear_valid             <= 1'b0;
+            game_over               <= 1'b0;
+        end else begin
+            clear_valid <= 1'b0;
+            game_over   <= 1'b0;
 
-    logic game_clk_meta, game_clk_sync, game_clk_sync_d;
-    logic game_clk_rise;
+            if (lock_step) begin
+                GAME_fixed_state.rows <= fixed_state_next.rows;
 
-    // Sync game_clk into clk domain and detect rising edges
+                // a piece completes at most four rows
+                if (clearing_line) begin
+                    lines_cleared <= lines_cleared + 16'(locked_clear_count);
+                    clear_count   <= 3'(locked_clear_count);
+                    clear_valid   <= 1'b1;
+                end
+                if (GAME_OVER) begin
+                    game_over_count <= game_over_count + 1;
+                    game_over       <= 1'b1;
+                end
+            end
+        end
+    end
+	
+    // Piece type comes from the queue head on spawn, or from the hold slot
     always_ff @(posedge clk) begin
         if (reset) begin
-            game_clk_meta   <= 1'b0;
-            game_clk_sync   <= 1'b0;
-            game_clk_sync_d <= 1'b0;
-        end else begin
-            game_clk_meta   <= game_clk;       // 1st stage
-            game_clk_sync   <= game_clk_meta;  // 2nd stage
-            game_clk_sync_d <= game_clk_sync;  // delayed copy
+            active_piece.piece_type <= tetris_pkg::PIECE_I;
+        end else if (spawn) begin
+            active_piece.piece_type <= new_piece.piece_type;
+        end else if (hold_applied) begin
+            active_piece.piece_type <= hold_valid ? hold_piece : new_piece.piece_type;
         end
     end
 
-    assign game_clk_rise = game_clk_sync & ~game_clk_sync_d;
-
     always_ff @(posedge clk) begin
         if (reset) begin
-            GAME_fixed_state.screen <= game_state_pkg::blank_game_state.screen;
-            clearing_line           <= 1'b0;
-        end else if (game_clk_rise) begin
-            // if (clearing_line | ) begin
-                GAME_fixed_state.screen <= fixed_state_next.screen;
-            // end 
-            clearing_line           <= clearing_line_next;
+            hold_valid <= 1'b0;
+            hold_used  <= 1'b0;
+        end else if (lock_step & GAME_OVER) begin
+            hold_valid <= 1'b0;
+            hold_used  <= 1'b0;
+        end else if (spawn) begin
+            hold_used  <= 1'b0;
+        end else if (hold_applied) begin
+            hold_piece <= active_piece.piece_type;
+            hold_valid <= 1'b1;
+            hold_used  <= 1'b1;
         end
     end
-	
-    flopRE_2clk #(.WIDTH($bits({new_piece.piece_type}))) flop_Piece_State(.clk_tree(clk), .target_clk(game_clk), .reset, .en(insert_new_piece), 
-                        .D({new_piece.piece_type}), 
-                        .Q({active_piece.piece_type}));
 
-    logic stalled_move_clk;
+    assign new_piece_taken = spawn | (hold_applied & ~hold_valid);
 
-    synchronizer Mv_clk_delay(.clk(clk), .raw_input(move_clk), .synchronized_value(stalled_move_clk));
+    // Commands are consumed one per clk from the command FIFO while a piece
+    // is on the board. A command waits out the lock and the spawn after it
+    // (at most two clocks), so none is applied to a piece that is being
+    // written into the board or that does not exist yet. A hard drop or hold
+    // in a gravity tick cycle wins the y flop; the tick no longer matters.
+    // A hold into an empty slot needs the queue head, so it waits while the
+    // queue refills instead of taking a stale piece and popping nothing.
+    assign hold_waiting = hold & ~hold_valid & ~new_piece_valid;
+    assign move_taken   = move_valid & ~reset & ~no_piece & ~lock_step & ~hold_waiting;
 
-    logic game_clk_q, move_clk_q;
+    assign hard_drop_applied = move_taken & hard_drop;
+    assign hold_applied      = move_taken & hold & ~hold_used & (hold_valid | new_piece_valid);
 
-    always_ff @(posedge clk) begin
-        if (reset) begin
-            game_clk_q          <= 1'b0;
-            move_clk_q  <= 1'b0;
-        end else begin
-            game_clk_q          <= game_clk;
-            move_clk_q  <= move_clk;
-        end
-    end
+    // move_taken already excludes the spawn cycle
+    assign rotate_applied    = move_taken & ~hard_drop & ~hold & (move == tetris_pkg::CMD_ROTATE) & kick_ok;
 
-    // One-cycle enables on rising edges (0 -> 1) of the slow "clocks"
-    wire game_clk_posedge  =  game_clk & ~game_clk_q;
-    wire move_clk_en  =  move_clk & ~move_clk_q;
-    logic game_clk_posedge_stalled;
+    // Any move that changed the piece, for the lock delay reset
+    assign move_applied      = rotate_applied |
+                               (move_taken & ~hard_drop & ~hold & ~active_piece_toutching_left  & (move == tetris_pkg::CMD_LEFT)) |
+                               (move_taken & ~hard_drop & ~hold & ~active_piece_toutching_right & (move == tetris_pkg::CMD_RIGHT));
 
     // ------------------------------------------------------------
     // Single flop for active_piece.x in the clk domain
@@ -237,42 +328,59 @@ module game_executioner #(
             active_piece.x <= 5'd7;   // or new_piece.x, your call
             active_piece.rotation <= tetris_pkg::ROT_0;
             count <= '0;
-            game_clk_posedge_stalled <= '0;
-        end else if (game_clk_posedge & insert_new_piece) begin
-            game_clk_posedge_stalled <= 1'b1;
-        end else if (game_clk_posedge_stalled & game_clk_posedge) begin
-            // Fires only on the cycle where game_clk goes 0->1
-            // and insert_new_piece is high in that same cycle
+        end else if (spawn) begin
+            // Same cycle as the type and y above
             active_piece.x        <= new_piece.x;
             active_piece.rotation <= new_piece.rotation;
             count <= count + 16;
-            game_clk_posedge_stalled <= 1'b0;
-        end else if (move_clk_en & move_valid) begin
+        end else if (hold_applied) begin
+            // Swapped-in piece starts over at the spawn point
+            active_piece.x        <= new_piece.x;
+            active_piece.rotation <= new_piece.rotation;
+        end else if (move_taken & ~hard_drop & ~hold) begin
             count <= count + 1;
-            // Fires only on the cycle where stalled_move_clk goes 0->1
-            // and move_valid is high
+            // Fires once per command popped from the FIFO
             if      (~active_piece_toutching_left & move == tetris_pkg::CMD_LEFT)       active_piece.x <= active_piece.x - 1;
             else if (~active_piece_toutching_right & move == tetris_pkg::CMD_RIGHT)     active_piece.x <= active_piece.x + 1;
-            else if (~rotation_blocked              & move == tetris_pkg::CMD_ROTATE)   begin
-                case (active_piece.rotation)
-                    tetris_pkg::ROT_0 :  active_piece.rotation <= tetris_pkg::ROT_90;
-                    tetris_pkg::ROT_90:  active_piece.rotation <= tetris_pkg::ROT_180;
-                    tetris_pkg::ROT_180: active_piece.rotation <= tetris_pkg::ROT_270;
-                    tetris_pkg::ROT_270: active_piece.rotation <= tetris_pkg::ROT_0;
-                    default:             active_piece.rotation <= tetris_pkg::ROT_90;
-                endcase
+            else if (rotate_applied)                                                    begin
+                // First free SRS kick offset; y is moved in the y flop above
+                active_piece.x        <= kick_x;
+                active_piece.rotation <= next_rotation;
             end
             //else count <= count - 1;
             // other moves: no change
         end
     end
 
-    blit_piece Blit_Piece(.no_piece, .base_state(GAME_fixed_state), .active_piece_grid, .out_state(GAME_state));
+    blit_piece Blit_Piece(.no_piece, .base_state(GAME_fixed_state), .active_piece_grid, .out_state(GAME_board));
+
+    // Ghost piece: the same grid moved down by landing_finder's drop, so it
+    // tracks every move and gravity step without a row-by-row search
+    tetris_pkg::active_piece_grid_t ghost_piece_grid;
+    game_state_pkg::bitboard_t      ghost_board;
+    game_state_pkg::game_state_t    ghost_frame;
+
+    always_comb begin
+        ghost_piece_grid   = active_piece_grid;
+        ghost_piece_grid.y = active_piece_grid.y + drop_rows;
+    end
+
+    blit_piece Blit_Ghost(.no_piece, .base_state(game_state_pkg::blank_bitboard), .active_piece_grid(ghost_piece_grid), .out_state(ghost_board));
+
+    // Column-major frame for the VGA side; the ghost hides under the piece once it lands
+    assign ghost_frame = game_state_pkg::to_game_state(ghost_board);
+
+    always_comb begin
+        GAME_state = game_state_pkg::to_game_state(GAME_board);
+        for (int x = 0; x < BOARD_WIDTH; x++) begin
+            GAME_state.ghost[x] = ghost_frame.screen[x] & ~GAME_state.screen[x];
+        end
+    end
 
 
     assign debug_singals_4[0] = no_piece;
     assign debug_singals_4[1] = clearing_line;
-    assign debug_singals_5[0] = clearing_line_next;
+    assign debug_singals_5[0] = clear_count;
     assign debug_singals_5[1] = active_piece.y;
 
 
@@ -0,0 +1,149 @@
+// gravity_engine.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/15/2025
+
+// Level-based gravity. game_tick fires once every frames_per_row[level]
+// VGA frames, counted on v_sync. The level starts at the start level and
+// goes up every lines_per_level cleared lines; a game over starts over.
+// A table entry of 0 is 20G: game_tick fires every frame with
+// gravity_20g set, and the piece falls all the way in that step.
+//
+// While soft_drop is held each frame counts soft_drop_factor times, so the
+// piece falls that many times faster on the same curve; more than one row
+// per frame comes out as ticks on consecutive clocks.
+//
+// The table, lines per level, start level and soft drop factor are
+// OP_CONFIG registers (spi_frame_pkg::CFG_*), so marathon and 20G curves
+// are a few SPI writes. Reset loads a marathon curve.
+
+module gravity_engine #(
+    parameter int LEVELS = spi_frame_pkg::GRAVITY_LEVELS
+) (
+    input  logic            clk,
+    input  logic            reset,
+
+    input  logic            v_sync,         // VGA domain, one pulse per frame
+    input  logic            soft_drop,      // soft drop key held
+
+    // Level progress
+    input  logic [2:0]      clear_count,
+    input  logic            clear_valid,
+    input  logic            game_over,
+
+    // OP_CONFIG writes
+    input  logic [7:0]      config_addr,
+    input  logic [7:0]      config_data,
+    input  logic            config_we,
+
+    output logic            frame_tick,     // one-cycle strobe per VGA frame
+    output logic            game_tick,      // one-cycle gravity enable
+    output logic            gravity_20g,    // with game_tick: fall to the landing row
+    output logic [$clog2(LEVELS)-1:0] level
+);
+
+    import spi_frame_pkg::*;
+
+    localparam int LEVEL_BITS = $clog2(LEVELS);
+
+    // Frames per row at 60 Hz, from 48 at level 0 down to 1
+    function automatic logic [7:0] marathon_frames(int lvl);
+        case (lvl)
+            0:  return 8'd48;   1:  return 8'd43;   2:  return 8'd38;   3:  return 8'd33;
+            4:  return 8'd28;   5:  return 8'd23;   6:  return 8'd18;   7:  return 8'd13;
+            8:  return 8'd8;    9:  return 8'd6;    10: return 8'd5;    11: return 8'd5;
+            12: return 8'd5;    13: return 8'd4;    14: return 8'd4;    15: return 8'd4;
+            16: return 8'd3;    17: return 8'd3;    18: return 8'd3;
+            default: return (lvl < 29) ? 8'd2 : 8'd1;
+        endcase
+    endfunction
+
+    logic [7:0]             frames_per_row [LEVELS];
+    logic [7:0]             lines_per_level;
+    logic [7:0]             soft_drop_factor;
+    logic [LEVEL_BITS-1:0]  start_level;
+    logic [7:0]             lines_in_level;
+
+    // ------------------------------------------------------------
+    // Frame tick from v_sync
+    // ------------------------------------------------------------
+    logic v_sync_sync, v_sync_prev;
+
+    synchronizer V_Sync_Synchronizer(.clk, .raw_input(v_sync), .synchronized_value(v_sync_sync));
+
+    always_ff @(posedge clk) v_sync_prev <= v_sync_sync;
+
+    assign frame_tick = v_sync_prev & ~v_sync_sync;     // start of the sync pulse
+
+    // ------------------------------------------------------------
+    // Configuration registers
+    // ------------------------------------------------------------
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            for (int i = 0; i < LEVELS; i++) frames_per_row[i] <= marathon_frames(i);
+            lines_per_level <= 8'd10;
+            start_level     <= '0;
+            soft_drop_factor <= 8'd20;
+        end else if (config_we) begin
+            if (config_addr < CFG_GRAVITY + LEVELS)     frames_per_row[config_addr[LEVEL_BITS-1:0]] <= config_data;
+            if (config_addr == CFG_LINES_PER_LEVEL)     lines_per_level <= (config_data == '0) ? 8'd1 : config_data;
+            if (config_addr == CFG_START_LEVEL)         start_level     <= config_data[LEVEL_BITS-1:0];
+            if (config_addr == CFG_SOFT_DROP)           soft_drop_factor <= (config_data == '0) ? 8'd1 : config_data;
+        end
+    end
+
+    // ------------------------------------------------------------
+    // Level from cleared lines
+    // ------------------------------------------------------------
+    logic [8:0] lines_total;
+
+    assign lines_total = lines_in_level + clear_count;
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            level          <= '0;
+            lines_in_level <= '0;
+        end else if (game_over) begin
+            level          <= start_level;
+            lines_in_level <= '0;
+        end else if (config_we & (config_addr == CFG_START_LEVEL)) begin
+            level          <= config_data[LEVEL_BITS-1:0];
+            lines_in_level <= '0;
+        end else if (clear_valid) begin
+            if (lines_total >= lines_per_level && level != LEVEL_BITS'(LEVELS - 1)) begin
+                level          <= level + 1;
+                lines_in_level <= 8'(lines_total - lines_per_level);
+            end else begin
+                lines_in_level <= (lines_total > 9'd255) ? 8'd255 : 8'(lines_total);
+            end
+        end
+    end
+
+    // ------------------------------------------------------------
+    // Gravity tick
+    //   progress counts frames (soft_drop_factor per frame while soft
+    //   dropping); each frames_per_row of it is one row, one per clock
+    // ------------------------------------------------------------
+    logic [15:0] progress;
+    logic [7:0]  period;
+    logic        row_due;
+
+    assign period      = frames_per_row[level];
+    assign gravity_20g = (period == '0);
+    assign row_due     = ~gravity_20g & (progress >= period);   // a shorter period takes effect at once
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            progress  <= '0;
+            game_tick <= 1'b0;
+        end else if (gravity_20g) begin
+            progress  <= '0;
+            game_tick <= frame_tick;
+        end else begin
+            game_tick <= row_due;
+            progress  <= progress - (row_due    ? 16'(period) : 16'd0)
+                                  + (frame_tick ? (soft_drop ? 16'(soft_drop_factor) : 16'd1) : 16'd0);
+        end
+    end
+
+endmodule
@@ -0,0 +1,105 @@
+// landing_finder.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/13/2025
+
+// Computes how many rows the active piece can fall before it lands, in one
+// combinational pass. For each column of the 4x4 piece grid the bottom
+// profile is the lowest filled cell; the board surface under it is the
+// first filled cell (or the floor) at or below that. The piece can fall the
+// smallest gap over its columns. Tetromino columns are contiguous, so only
+// the bottom cell of each column needs checking.
+//
+// Where the piece is above a column's skyline (skyline.sv) the surface is
+// that register. A piece tucked under an overhang takes the first filled
+// cell at or below its bottom cell in that column, from one lsb_index per
+// piece column over the column masked to those rows (the floor when none).
+// A piece overlapping the board reports 0, so it counts as landed. A piece
+// partly above the board (the grid reaches row -4 at y = 0) can fall up to
+// BOARD_HEIGHT + 3 rows.
+
+module landing_finder #(
+    parameter int BOARD_WIDTH  = 10,
+    parameter int BOARD_HEIGHT = 20
+) (
+    input  game_state_pkg::bitboard_t           board,
+    input  logic [$clog2(BOARD_HEIGHT+1)-1:0]   top_row [BOARD_WIDTH],  // skyline.sv
+    input  tetris_pkg::active_piece_grid_t      active_piece_grid,
+    output logic [$clog2(BOARD_HEIGHT+4)-1:0]   drop_rows       // 0 when already resting
+);
+
+    localparam int ROW_BITS = $clog2(BOARD_HEIGHT+1);
+
+    // Per piece column: its board column, the row of its bottom cell, and
+    // whether it has a cell inside the board's width
+    int   bx        [4];
+    int   by_bottom [4];
+    logic in_play   [4];
+
+    always_comb begin
+        int bottom_dy;
+
+        for (int dx = 0; dx < 4; dx++) begin
+            // Bottom profile: lowest filled cell of this piece column
+            bottom_dy = -1;
+            for (int dy = 0; dy < 4; dy++) begin
+                if (active_piece_grid.piece[dx][dy]) bottom_dy = dy;
+            end
+
+            // Same grid-to-board offset as blit_piece
+            bx[dx]        = active_piece_grid.x + dx - 4;
+            by_bottom[dx] = active_piece_grid.y + bottom_dy - 4;
+            in_play[dx]   = (bottom_dy >= 0) && (bx[dx] >= 0) && (bx[dx] < BOARD_WIDTH);
+        end
+    end
+
+    // Under an overhang: first filled cell at or below the bottom cell (an
+    // overlap if it is the bottom cell's own row)
+    logic [ROW_BITS-1:0] overhang_surface [4];
+
+    genvar gdx;
+    generate
+        for (gdx = 0; gdx < 4; gdx++) begin : Overhang_scan
+            logic [BOARD_HEIGHT-1:0] below;
+
+            always_comb begin
+                for (int y = 0; y < BOARD_HEIGHT; y++)
+                    below[y] = in_play[gdx] && (y >= by_bottom[gdx]) && board.rows[y][bx[gdx]];
+            end
+
+            // Returns BOARD_HEIGHT (the floor) when nothing is below
+            lsb_index #(
+                .WIDTH(BOARD_HEIGHT)
+            ) Surface (
+                .in  (below),
+                .idx (overhang_surface[gdx])
+            );
+        end
+    endgenerate
+
+    always_comb begin
+        int   surface, gap, min_gap;
+        logic found;
+
+        min_gap = 0;
+        found   = 1'b0;
+
+        for (int dx = 0; dx < 4; dx++) begin
+            if (in_play[dx]) begin
+                // Above the column its skyline is the surface
+                if (by_bottom[dx] < int'(top_row[bx[dx]])) surface = top_row[bx[dx]];
+                else                                       surface = overhang_surface[dx];
+
+                gap = surface - by_bottom[dx] - 1;
+                if (!found || gap < min_gap) min_gap = gap;
+                found = 1'b1;
+            end
+        end
+
+        // An empty grid has nothing to drop (min_gap stays 0); an overlap
+        // counts as landed
+        if (min_gap < 0) min_gap = 0;
+        drop_rows = min_gap[$clog2(BOARD_HEIGHT+4)-1:0];
+    end
+
+endmodule
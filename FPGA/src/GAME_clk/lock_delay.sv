@@ -0,0 +1,67 @@
+// lock_delay.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/15/2025
+
+// Lock delay: a landed piece locks after lock_frames VGA frames on the
+// ground instead of on the next gravity tick. Every move or rotation that
+// succeeds while landed restarts the count, up to reset_limit times per
+// piece, so a piece can be slid along the stack but not stalled forever.
+// Lifting off the stack (e.g. a kick over a ledge) also restarts it.
+//
+// Runs on the game clk, so a move restarts the count in the cycle it is
+// applied. lock_frames = 0 locks as soon as the piece lands.
+//
+// lock_frames and reset_limit are OP_CONFIG registers (spi_frame_pkg::CFG_*).
+
+module lock_delay (
+    input  logic            clk,
+    input  logic            reset,
+
+    input  logic            frame_tick,     // one pulse per VGA frame
+    input  logic            landed,         // active piece rests on the stack or floor
+    input  logic            moved,          // a move or rotation was applied this cycle
+    input  logic            spawn,          // a new piece entered the board
+
+    // OP_CONFIG writes
+    input  logic [7:0]      config_addr,
+    input  logic [7:0]      config_data,
+    input  logic            config_we,
+
+    output logic            lock            // lock the piece this cycle
+);
+
+    import spi_frame_pkg::*;
+
+    logic [7:0] lock_frames;
+    logic [7:0] reset_limit;
+    logic [7:0] frame_count;
+    logic [7:0] resets_used;
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            lock_frames <= 8'd30;      // 0.5 s
+            reset_limit <= 8'd15;
+        end else if (config_we) begin
+            if (config_addr == CFG_LOCK_FRAMES)  lock_frames <= config_data;
+            if (config_addr == CFG_LOCK_RESETS)  reset_limit <= config_data;
+        end
+    end
+
+    assign lock = landed & (frame_count >= lock_frames);
+
+    always_ff @(posedge clk) begin
+        if (reset | spawn) begin
+            frame_count <= '0;
+            resets_used <= '0;
+        end else if (~landed) begin
+            frame_count <= '0;
+        end else if (moved & (resets_used < reset_limit)) begin
+            frame_count <= '0;
+            resets_used <= resets_used + 1;
+        end else if (frame_tick & ~lock) begin
+            frame_count <= frame_count + 1;
+        end
+    end
+
+endmodule
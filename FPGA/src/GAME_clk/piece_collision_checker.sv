@@ -23,7 +23,7 @@ module piece_collision_checker #(
     parameter int BOARD_HEIGHT = 20
 ) ( 
         input   logic                               no_piece,
-        input   game_state_pkg::game_state_t        GAME_fixed_state,
+        input   game_state_pkg::bitboard_t          GAME_fixed_state,
         input   logic[$clog2(BOARD_WIDTH) -1:0]     piece_x,
         input   logic[$clog2(BOARD_HEIGHT)-1:0]     piece_y,
 
@@ -2,6 +2,13 @@
 // James Kaden Cassidy
 // kacassidy@hmc.edu
 // 12/1/2025
+
+// Shape of the active piece as a 4x4 grid, in the Super Rotation System
+// states: the spawn shapes below, turned clockwise about the centre of their
+// SRS box (3x3 at the top left for JLSTZ, the whole 4x4 for I; O does not
+// turn). srs_kick's offsets assume exactly these states. All 28 shapes
+// (7 pieces x 4 rotations) are a ROM built at elaboration, so decoding is
+// one lookup on {piece_type, rotation}.
 module piece_decoder (
     input  tetris_pkg::active_piece_t        active_piece,
     output tetris_pkg::active_piece_grid_t   active_piece_grid
@@ -9,11 +16,11 @@ module piece_decoder (
 
     import tetris_pkg::*;
 
-  // 4x4 matrix type: [row][col], row 0 = top, col 0 = left
-  typedef logic [3:0] piece_matrix_t [3:0];
+  // 4x4 matrix type: [row][col], row 0 = top, col 0 = left, as drawn below
+  typedef logic [0:3] piece_matrix_t [0:3];
 
   // ---------------------------------------------------------------------------
-  // Base (ROT_0) shapes as 4x4 matrices (constants).
+  // SRS spawn (ROT_0) shapes
   // ---------------------------------------------------------------------------
 
   localparam piece_matrix_t I_BASE = '{
@@ -22,109 +29,118 @@ module piece_decoder (
       '{1'b0, 1'b0, 1'b0, 1'b0}, // row 2
       '{1'b0, 1'b0, 1'b0, 1'b0}  // row 3
   };
-  
+
   localparam piece_matrix_t O_BASE = '{
-      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b1, 1'b1, 1'b0},
       '{1'b0, 1'b1, 1'b1, 1'b0},
+      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b0, 1'b0, 1'b0}
   };
 
   localparam piece_matrix_t T_BASE = '{
-      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b1, 1'b0, 1'b0},
       '{1'b1, 1'b1, 1'b1, 1'b0},
+      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b0, 1'b0, 1'b0}
   };
 
   localparam piece_matrix_t L_BASE = '{
-      '{1'b0, 1'b1, 1'b0, 1'b0},
-      '{1'b0, 1'b1, 1'b0, 1'b0},
-      '{1'b0, 1'b1, 1'b1, 1'b0},
+      '{1'b0, 1'b0, 1'b1, 1'b0},
+      '{1'b1, 1'b1, 1'b1, 1'b0},
+      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b0, 1'b0, 1'b0}
   };
 
   localparam piece_matrix_t J_BASE = '{
-      '{1'b0, 1'b0, 1'b1, 1'b0},
-      '{1'b0, 1'b0, 1'b1, 1'b0},
-      '{1'b0, 1'b1, 1'b1, 1'b0},
+      '{1'b1, 1'b0, 1'b0, 1'b0},
+      '{1'b1, 1'b1, 1'b1, 1'b0},
+      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b0, 1'b0, 1'b0}
   };
 
   localparam piece_matrix_t S_BASE = '{
-      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b1, 1'b1, 1'b0},
       '{1'b1, 1'b1, 1'b0, 1'b0},
+      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b0, 1'b0, 1'b0}
   };
 
   localparam piece_matrix_t Z_BASE = '{
-      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b1, 1'b1, 1'b0, 1'b0},
       '{1'b0, 1'b1, 1'b1, 1'b0},
+      '{1'b0, 1'b0, 1'b0, 1'b0},
       '{1'b0, 1'b0, 1'b0, 1'b0}
   };
 
+  function automatic piece_matrix_t base_shape(piece_type_t piece);
+    case (piece)
+      PIECE_I: return I_BASE;
+      PIECE_O: return O_BASE;
+      PIECE_T: return T_BASE;
+      PIECE_L: return L_BASE;
+      PIECE_J: return J_BASE;
+      PIECE_S: return S_BASE;
+      PIECE_Z: return Z_BASE;
+      default: return '{default: 4'b0};
+    endcase
+  endfunction
+
   // ---------------------------------------------------------------------------
-  // Internal 4x4 matrices: base + rotated
+  // One shape as a 16-bit mask, bit {x, y} = grid cell [x][y] = column x,
+  // row y of the matrix
   // ---------------------------------------------------------------------------
-  piece_matrix_t base_matrix;
-  piece_matrix_t rotated;
+  function automatic logic [15:0] piece_mask(piece_type_t piece, rotation_t rotation);
+    piece_matrix_t shape, turned;
+    int            n;
+    logic [15:0]   mask;
+
+    shape = base_shape(piece);
+    n     = (piece == PIECE_I) ? 4 : 3;   // SRS box size
+
+    // Clockwise quarter turns: row r, col c <- row n-1-c, col r
+    if (piece != PIECE_O) begin
+      for (int t = 0; t < int'(rotation); t++) begin
+        turned = '{default: 4'b0};
+        for (int r = 0; r < n; r++)
+          for (int c = 0; c < n; c++)
+            turned[r][c] = shape[n-1-c][r];
+        shape = turned;
+      end
+    end
+
+    for (int x = 0; x < 4; x++)
+      for (int y = 0; y < 4; y++)
+        mask[4*x + y] = shape[y][x];
+    return mask;
+  endfunction
 
   // ---------------------------------------------------------------------------
-  // Pure combinational decode + rotation + packing
+  // Every piece and rotation, built at elaboration and indexed by
+  // {piece_type, rotation}
   // ---------------------------------------------------------------------------
-  always_comb begin
-    int y, x, r, c;
+  localparam int PIECE_ROM_ENTRIES = 7 * 4;
 
-    // Default: clear base_matrix
-    for (y = 0; y < 4; y++) begin
-      for (x = 0; x < 4; x++) begin
-        base_matrix[x][y] = 1'b0;
-      end
-    end
+  function automatic logic [PIECE_ROM_ENTRIES-1:0][15:0] build_piece_rom();
+    logic [PIECE_ROM_ENTRIES-1:0][15:0] rom;
+    for (int p = 0; p < 7; p++)
+      for (int r = 0; r < 4; r++)
+        rom[4*p + r] = piece_mask(piece_type_t'(p), rotation_t'(r));
+    return rom;
+  endfunction
 
-    // Select base shape for ROT_0
-    unique case (active_piece.piece_type)
-      PIECE_I: base_matrix = I_BASE;
-      PIECE_O: base_matrix = O_BASE;
-      PIECE_T: base_matrix = T_BASE;
-      PIECE_L: base_matrix = L_BASE;
-      PIECE_J: base_matrix = J_BASE;
-      PIECE_S: base_matrix = S_BASE;
-      PIECE_Z: base_matrix = Z_BASE;
-      default: /* keep zeros */;
-    endcase
+  localparam logic [PIECE_ROM_ENTRIES-1:0][15:0] PIECE_ROM = build_piece_rom();
 
-    for (r = 0; r < 4; r++) begin
-      for (c = 0; c < 4; c++) begin
-          x = 3-c;
-          y = 3-r;
-          rotated[x][y] = base_matrix[r][c];
-      end
-    end
-    base_matrix = rotated;
-
-    // Apply rotation (combinational, no functions)
-    for (y = 0; y < 4; y++) begin
-      for (x = 0; x < 4; x++) begin
-        unique case (active_piece.rotation)
-          ROT_0:   rotated[x][y] = base_matrix[x][y];
-          // 90Â° clockwise: (y,x) <- (3-x, y)
-          ROT_90:  rotated[x][y] = base_matrix[y][3-x];
-          // 180Â°: (y,x) <- (3-y,3-x)
-          ROT_180: rotated[x][y] = base_matrix[3-x][3-y];
-          // 270Â° clockwise: (y,x) <- (x,3-y)
-          ROT_270: rotated[x][y] = base_matrix[3-y][x];
-          default: rotated[x][y] = base_matrix[x][y];
-        endcase
-      end
-    end
+  // ---------------------------------------------------------------------------
+  // Lookup
+  // ---------------------------------------------------------------------------
+  logic [4:0]  rom_index;
+  logic [15:0] mask;
 
-    // Pack rotated rows into active_piece_grid.piece[y][3:0] = {right..left}
-    for (x = 0; x < 4; x++) begin
-      active_piece_grid.piece = rotated;
-    end
+  assign rom_index = {active_piece.piece_type, active_piece.rotation};
+  assign mask      = (rom_index < PIECE_ROM_ENTRIES) ? PIECE_ROM[rom_index] : '0;
+
+  always_comb begin
+    for (int x = 0; x < 4; x++) active_piece_grid.piece[x] = mask[4*x +: 4];
 
     // Top-left of the 4x4 grid in board coordinates
     active_piece_grid.x = active_piece.x;
@@ -11,7 +11,7 @@ module piece_mask_generator #(
     parameter int BOARD_WIDTH  = 10,
     parameter int BOARD_HEIGHT = 20
 ) (
-    input  game_state_pkg::game_state_t         state,
+    input  game_state_pkg::bitboard_t           state,
 
     // Top-left of screen is (0,0), x right, y down.
     input  logic [$clog2(BOARD_WIDTH) -1:0]     piece_x,
@@ -46,8 +46,8 @@ module piece_mask_generator #(
 
                     // If vertically on-screen, sample from state
                     if (wy >= 0 && wy < BOARD_HEIGHT) begin
-                        // state.screen[wx] is a BOARD_HEIGHT-bit column
-                        col_bits[ly] = state.screen[wx][wy];
+                        // state.rows[wy] is a BOARD_WIDTH-bit row
+                        col_bits[ly] = state.rows[wy][wx];
                     end else if (wy < 0) begin
                         col_bits[ly] = 1'b0;
                     end
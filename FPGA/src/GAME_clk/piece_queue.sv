@@ -0,0 +1,62 @@
+// piece_queue.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/14/2025
+
+// Next-piece preview queue. Entry 0 is the piece that spawns next; pop
+// shifts the queue by one as that piece enters the board. Empty slots at
+// the back are refilled from fill_piece, one per clock, so the queue is
+// full again long before the next spawn; fill_taken tells the randomizer
+// its piece was used. flush empties the queue (e.g. after a new seed).
+
+module piece_queue #(
+    parameter int DEPTH = 5
+) (
+    input  logic                        clk,
+    input  logic                        reset,
+
+    input  tetris_pkg::piece_type_t     fill_piece,     // randomizer output
+    output logic                        fill_taken,
+    input  logic                        pop,            // entry 0 was spawned
+    input  logic                        flush,
+
+    output tetris_pkg::piece_type_t     next_pieces [DEPTH],
+    output logic [DEPTH-1:0]            next_valid
+);
+
+    tetris_pkg::piece_type_t    shifted_pieces [DEPTH];
+    logic [DEPTH-1:0]           shifted_valid;
+
+    // Queue after this cycle's pop
+    always_comb begin
+        for (int i = 0; i < DEPTH; i++) begin
+            if (pop & (i < DEPTH - 1)) begin
+                shifted_pieces[i] = next_pieces[i + 1];
+                shifted_valid[i]  = next_valid[i + 1];
+            end else begin
+                shifted_pieces[i] = next_pieces[i];
+                shifted_valid[i]  = next_valid[i] & ~pop;
+            end
+        end
+    end
+
+    assign fill_taken = ~reset & ~flush & ~&shifted_valid;
+
+    always_ff @(posedge clk) begin
+        if (reset | flush) begin
+            next_valid <= '0;
+        end else begin
+            for (int i = 0; i < DEPTH; i++) begin
+                // Slots fill front to back, so only the first empty one refills
+                if (~shifted_valid[i] & ((i == 0) || shifted_valid[i - 1])) begin
+                    next_pieces[i] <= fill_piece;
+                    next_valid[i]  <= 1'b1;
+                end else begin
+                    next_pieces[i] <= shifted_pieces[i];
+                    next_valid[i]  <= shifted_valid[i];
+                end
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,49 @@
+// row_compactor.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/12/2025
+
+// Removes every full row of a board in one pass. Row 0 is the top, so each
+// surviving row drops by the number of full rows below it; that prefix
+// count picks, for every destination row, the one source row that lands
+// there. Rows nothing lands on (the top cleared_count rows) come out empty.
+
+module row_compactor #(
+    parameter int BOARD_WIDTH  = 10,
+    parameter int BOARD_HEIGHT = 20
+) (
+    input  game_state_pkg::bitboard_t           in_state,
+    output game_state_pkg::bitboard_t           out_state,
+    output logic [$clog2(BOARD_HEIGHT+1)-1:0]   cleared_count
+);
+
+    localparam int COUNT_BITS = $clog2(BOARD_HEIGHT+1);
+
+    logic                   row_full [BOARD_HEIGHT];
+    logic [COUNT_BITS-1:0]  full_below [BOARD_HEIGHT];  // full rows with a larger y
+
+    always_comb begin
+        for (int y = 0; y < BOARD_HEIGHT; y++) begin
+            row_full[y] = &in_state.rows[y];
+        end
+
+        full_below[BOARD_HEIGHT-1] = '0;
+        for (int y = BOARD_HEIGHT-2; y >= 0; y--) begin
+            full_below[y] = full_below[y+1] + COUNT_BITS'(row_full[y+1]);
+        end
+
+        cleared_count = full_below[0] + COUNT_BITS'(row_full[0]);
+
+        // Destination row d takes source row s <= d when s survives and
+        // drops exactly d - s rows; at most one s matches
+        out_state = game_state_pkg::blank_bitboard;
+        for (int d = 0; d < BOARD_HEIGHT; d++) begin
+            for (int s = 0; s <= d; s++) begin
+                if (~row_full[s] && full_below[s] == COUNT_BITS'(d - s)) begin
+                    out_state.rows[d] |= in_state.rows[s];
+                end
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,86 @@
+// skyline.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/14/2025
+
+// Per-column surface registers for the fixed board: top_row[x] is the
+// topmost filled row of column x (row 0 is the top), BOARD_HEIGHT when the
+// column is empty, so the column height is BOARD_HEIGHT - top_row[x].
+//
+// A plain lock only ever raises columns, so it is applied incrementally:
+// each column takes the higher of its surface and the piece's top cell in
+// that column. A lock that clears lines can expose any row of a column, so
+// the columns are rescanned from the compacted board; that happens at most
+// once per line clear, never per move. A game over empties every column.
+
+module skyline #(
+    parameter int BOARD_WIDTH  = 10,
+    parameter int BOARD_HEIGHT = 20
+) (
+    input  logic                                clk,
+    input  logic                                reset,
+
+    input  logic                                lock,           // piece locks this cycle
+    input  logic                                clear,          // ... and completes rows
+    input  logic                                wipe,           // board is blanked (game over)
+    input  tetris_pkg::active_piece_grid_t      active_piece_grid,
+    input  game_state_pkg::bitboard_t           cleared_board,  // board after the clear
+
+    output logic [$clog2(BOARD_HEIGHT+1)-1:0]   top_row [BOARD_WIDTH]
+);
+
+    localparam int ROW_BITS = $clog2(BOARD_HEIGHT+1);
+
+    // Topmost cell of the piece in each board column (BOARD_HEIGHT if none)
+    logic [ROW_BITS-1:0] piece_top [BOARD_WIDTH];
+
+    always_comb begin
+        int bx, by;
+
+        for (int x = 0; x < BOARD_WIDTH; x++) piece_top[x] = ROW_BITS'(BOARD_HEIGHT);
+
+        // Same grid-to-board offset as blit_piece; scan bottom-up so the top cell wins
+        for (int dx = 0; dx < 4; dx++) begin
+            bx = active_piece_grid.x + dx - 4;
+            for (int dy = 3; dy >= 0; dy--) begin
+                by = active_piece_grid.y + dy - 4;
+                if (active_piece_grid.piece[dx][dy] && bx >= 0 && bx < BOARD_WIDTH &&
+                    by >= 0 && by < BOARD_HEIGHT) begin
+                    piece_top[bx] = ROW_BITS'(by);
+                end
+            end
+        end
+    end
+
+    // Rescan after a clear: columns of the compacted board
+    logic [ROW_BITS-1:0] scan_top [BOARD_WIDTH];
+
+    genvar gx;
+    generate
+        for (gx = 0; gx < BOARD_WIDTH; gx++) begin : Column_scan
+            logic [BOARD_HEIGHT-1:0] column;
+
+            always_comb begin
+                for (int y = 0; y < BOARD_HEIGHT; y++) column[y] = cleared_board.rows[y][gx];
+            end
+
+            // Returns BOARD_HEIGHT for an empty column
+            lsb_index #(
+                .WIDTH(BOARD_HEIGHT)
+            ) Top_row (
+                .in  (column),
+                .idx (scan_top[gx])
+            );
+        end
+    endgenerate
+
+    always_ff @(posedge clk) begin
+        for (int x = 0; x < BOARD_WIDTH; x++) begin
+            if (reset | wipe)               top_row[x] <= ROW_BITS'(BOARD_HEIGHT);
+            else if (lock & clear)          top_row[x] <= scan_top[x];
+            else if (lock & (piece_top[x] < top_row[x]))
+                                            top_row[x] <= piece_top[x];
+        end
+    end
+
+endmodule
@@ -0,0 +1,98 @@
+// srs_kick.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/14/2025
+
+// Clockwise rotation with Super Rotation System wall kicks. The rotated
+// grid (from a second piece_decoder) is tested at all five kick offsets of
+// the current rotation's row of the kick table at once; the first offset
+// where it fits the board is taken, so a kicked rotation costs no extra
+// cycles. I has its own table, O never kicks, JLSTZ share the other.
+//
+// Offsets are in board coordinates (x right, y down), i.e. the SRS tables
+// with y negated. Cells above the board are free, as in piece_mask_generator.
+
+module srs_kick #(
+    parameter int BOARD_WIDTH  = 10,
+    parameter int BOARD_HEIGHT = 20
+) (
+    input  game_state_pkg::bitboard_t           board,
+    input  tetris_pkg::piece_type_t             piece_type,
+    input  tetris_pkg::rotation_t               rotation,       // before the rotation
+    input  logic [3:0]                          rotated_piece [3:0],
+    input  logic [3:0]                          piece_x,
+    input  logic [4:0]                          piece_y,
+
+    output logic                                kick_ok,        // some offset fits
+    output logic [3:0]                          kick_x,
+    output logic [4:0]                          kick_y
+);
+
+    import tetris_pkg::*;
+
+    localparam int NUM_KICKS = 5;
+
+    typedef int kick_row_t [NUM_KICKS][2];     // {dx, dy} per test
+
+    // JLSTZ: 0->R, R->2, 2->L, L->0
+    localparam kick_row_t JLSTZ_KICKS [4] = '{
+        '{'{0, 0}, '{-1, 0}, '{-1, -1}, '{0,  2}, '{-1,  2}},
+        '{'{0, 0}, '{ 1, 0}, '{ 1,  1}, '{0, -2}, '{ 1, -2}},
+        '{'{0, 0}, '{ 1, 0}, '{ 1, -1}, '{0,  2}, '{ 1,  2}},
+        '{'{0, 0}, '{-1, 0}, '{-1,  1}, '{0, -2}, '{-1, -2}}
+    };
+
+    // I: 0->R, R->2, 2->L, L->0
+    localparam kick_row_t I_KICKS [4] = '{
+        '{'{0, 0}, '{-2, 0}, '{ 1, 0}, '{-2,  1}, '{ 1, -2}},
+        '{'{0, 0}, '{-1, 0}, '{ 2, 0}, '{-1, -2}, '{ 2,  1}},
+        '{'{0, 0}, '{ 2, 0}, '{-1, 0}, '{ 2, -1}, '{-1,  2}},
+        '{'{0, 0}, '{ 1, 0}, '{-2, 0}, '{ 1,  2}, '{-2, -1}}
+    };
+
+    kick_row_t              kicks;
+    logic [NUM_KICKS-1:0]   fits;
+
+    always_comb begin
+        int px, py, bx, by;
+
+        unique case (piece_type)
+            PIECE_I: kicks = I_KICKS[rotation];
+            PIECE_O: kicks = '{default: 0};
+            default: kicks = JLSTZ_KICKS[rotation];
+        endcase
+
+        // Every offset checked in parallel against the board
+        for (int k = 0; k < NUM_KICKS; k++) begin
+            px = piece_x + kicks[k][0];
+            py = piece_y + kicks[k][1];
+
+            fits[k] = (px >= 0) && (px < 16) && (py >= 0) && (py < 32);
+
+            for (int dx = 0; dx < 4; dx++) begin
+                for (int dy = 0; dy < 4; dy++) begin
+                    // Same grid-to-board offset as blit_piece
+                    bx = px + dx - 4;
+                    by = py + dy - 4;
+                    if (rotated_piece[dx][dy]) begin
+                        if (bx < 0 || bx >= BOARD_WIDTH || by >= BOARD_HEIGHT)  fits[k] = 1'b0;
+                        else if (by >= 0 && board.rows[by][bx])                fits[k] = 1'b0;
+                    end
+                end
+            end
+        end
+
+        // First free offset wins
+        kick_ok = 1'b0;
+        kick_x  = piece_x;
+        kick_y  = piece_y;
+        for (int k = NUM_KICKS-1; k >= 0; k--) begin
+            if (fits[k]) begin
+                kick_ok = 1'b1;
+                kick_x  = 4'(piece_x + kicks[k][0]);
+                kick_y  = 5'(piece_y + kicks[k][1]);
+            end
+        end
+    end
+
+endmodule
@@ -11,9 +11,9 @@ module tb_blit_piece;
 
     // DUT inputs/outputs
     logic              no_piece;
-    game_state_t       base_state;
+    bitboard_t       base_state;
     active_piece_grid_t active_piece_grid;
-    game_state_t       out_state;
+    bitboard_t       out_state;
 
     // DUT instance
     blit_piece dut (
@@ -26,14 +26,14 @@ module tb_blit_piece;
     // ----------------------------------------------------------------
     // Utility: pretty-print the board as 10x20 ASCII grid
     // ----------------------------------------------------------------
-    task automatic print_state(string label, game_state_t s);
+    task automatic print_state(string label, bitboard_t s);
         $display("=== %s ===", label);
         // y = 19 (top) down to 0 (bottom) if bit 19=top, 0=bottom.
         for (int y = 19; y >= 0; y--) begin
             $write("%2d | ", y);
             for (int x = 0; x < 10; x++) begin
-                // screen[x][y] is 1 => filled cell
-                if (s.screen[x][y])
+                // rows[y][x] is 1 => filled cell
+                if (s.rows[y][x])
                     $write("#");
                 else
                     $write(".");
@@ -98,7 +98,7 @@ module tb_blit_piece;
 
         // Pre-fill a simple pattern in base_state (e.g., bottom row full)
         for (int x = 0; x < 10; x++) begin
-            base_state.screen[x][0] = 1'b1;  // y = 0 row
+            base_state.rows[0][x] = 1'b1;  // y = 0 row
         end
 
         // Keep the same active_piece_grid as in Test 2
@@ -0,0 +1,259 @@
+// tb_game_executioner.sv
+// Integration testbench for game_executioner, spawn through lock: commands
+// wait while there is no piece, the queue head spawns whole on one clk,
+// gravity (and a tick owed to a move), a hard drop that locks on the next
+// clk with the next piece spawning on the clk after, and a 20G landing
+// that locks after the lock delay and clears a row.
+
+`timescale 1ns/1ps
+
+import tetris_pkg::*;
+import game_state_pkg::*;
+import spi_frame_pkg::*;
+
+module tb_game_executioner;
+
+    logic           clk = 0;
+    logic           reset;
+    logic           move_valid;
+    logic           hard_drop;
+    logic           hold;
+    logic           move_taken;
+    logic           game_tick;
+    logic           gravity_20g;
+    logic           frame_tick;
+    logic [7:0]     config_addr;
+    logic [7:0]     config_data;
+    logic           config_we;
+    command_t       move;
+    active_piece_t  new_piece;
+    logic           new_piece_valid;
+    logic           new_piece_taken;
+    game_state_t    GAME_state;
+    bitboard_t      GAME_fixed_state;
+    active_piece_t  active_piece;
+    logic [15:0]    lines_cleared;
+    logic [2:0]     clear_count;
+    logic           clear_valid;
+    logic [7:0]     game_over_count;
+    logic           game_over;
+    logic [4:0]     column_top [10];
+    piece_type_t    hold_piece;
+    logic           hold_valid;
+    logic [5:0]     debug_window_0 [3][5:0];
+    logic [5:0]     debug_window_1 [3][5:0];
+    logic [5:0]     debug_window_2 [3][5:0];
+    logic [5:0]     debug_window_3 [3][5:0];
+    logic [5:0]     debug_window_4 [3][5:0];
+    logic [5:0]     debug_window_5 [3][5:0];
+    logic [7:0]     debug_singals_0 [2];
+    logic [7:0]     debug_singals_1 [2];
+    logic [7:0]     debug_singals_2 [2];
+    logic [7:0]     debug_singals_3 [2];
+    logic [7:0]     debug_singals_4 [2];
+    logic [7:0]     debug_singals_5 [2];
+
+    game_executioner #(
+        .TELEMETRY_NUM_SIGNALS(2),
+        .TELEMETRY_VALUE_WIDTH(8),
+        .TELEMETRY_BASE       (2)
+    ) dut (.*);
+
+    always #5 clk = ~clk;
+
+    // Next-piece queue: the tb releases one entry at a time by raising queued
+    localparam piece_type_t PIECES [3] = '{PIECE_T, PIECE_I, PIECE_J};
+
+    int head;
+    int queued;
+
+    assign new_piece_valid = (head < queued);
+    assign new_piece       = make_piece(PIECES[head < 3 ? head : 0], ROT_0);
+
+    // Strobe counters
+    int taken_pulses;
+    int clear_pulses;
+    int game_over_pulses;
+
+    always @(posedge clk) begin
+        if (reset) begin
+            head         <= 0;
+            taken_pulses <= 0;
+        end else if (new_piece_taken) begin
+            head         <= head + 1;
+            taken_pulses <= taken_pulses + 1;
+        end
+        if (reset) begin
+            clear_pulses     <= 0;
+            game_over_pulses <= 0;
+        end else begin
+            if (clear_valid) clear_pulses     <= clear_pulses + 1;
+            if (game_over)   game_over_pulses <= game_over_pulses + 1;
+        end
+    end
+
+    task automatic check(string name, input logic pass);
+        if (!pass) $error("%s FAILED: piece type %0d rot %0d x %0d y %0d, move_taken %b",
+                        name, active_piece.piece_type, active_piece.rotation,
+                        active_piece.x, active_piece.y, move_taken);
+        else     $display("%s PASSED", name);
+    endtask
+
+    function automatic logic piece_is(piece_type_t piece, rotation_t rotation, int x, int y);
+        return active_piece.piece_type == piece && active_piece.rotation == rotation &&
+               active_piece.x == x && active_piece.y == y;
+    endfunction
+
+    // Present a command at the FIFO head and hold it until it is taken
+    task automatic send(input logic drop, input command_t cmd);
+        move_valid = 1'b1;
+        hard_drop  = drop;
+        move       = cmd;
+        #1;
+        while (!move_taken) @(negedge clk);
+        @(negedge clk);
+        move_valid = 1'b0;
+        hard_drop  = 1'b0;
+    endtask
+
+    task automatic send_n(input command_t cmd, input int n);
+        repeat (n) send(1'b0, cmd);
+    endtask
+
+    task automatic pulse_frame();
+        frame_tick = 1'b1;
+        @(negedge clk);
+        frame_tick = 1'b0;
+    endtask
+
+    logic ok;
+
+    initial begin
+        $display("=== tb_game_executioner starting ===");
+
+        reset       = 1'b1;
+        move_valid  = 1'b0;
+        hard_drop   = 1'b0;
+        hold        = 1'b0;
+        move        = CMD_LEFT;
+        game_tick   = 1'b0;
+        gravity_20g = 1'b0;
+        frame_tick  = 1'b0;
+        config_addr = '0;
+        config_data = '0;
+        config_we   = 1'b0;
+        queued      = 0;
+        repeat (2) @(negedge clk);
+        reset = 1'b0;
+
+        // Lock after 2 frames on the ground
+        config_addr = CFG_LOCK_FRAMES;
+        config_data = 8'd2;
+        config_we   = 1'b1;
+        @(negedge clk);
+        config_we   = 1'b0;
+
+        // Test 1: with the queue empty there is no piece, nothing spawns and
+        // a waiting command is not taken
+        move_valid = 1'b1;
+        move       = CMD_LEFT;
+        ok = 1'b1;
+        repeat (4) begin
+            @(negedge clk);
+            if (move_taken || new_piece_taken) ok = 1'b0;
+        end
+        check("Test 1", ok && taken_pulses == 0);
+
+        // Test 2: the queue head spawns on the next clk with type, rotation,
+        // x and y loaded together; the waiting command is taken after it
+        queued = 1;
+        #1;
+        ok = new_piece_taken && !move_taken;
+        @(negedge clk);
+        ok &= piece_is(PIECE_T, ROT_0, 7, 1) && taken_pulses == 1 && !new_piece_taken && move_taken;
+        @(negedge clk);
+        move_valid = 1'b0;
+        ok &= piece_is(PIECE_T, ROT_0, 6, 1);
+        check("Test 2", ok);
+
+        // Test 3: a gravity tick that meets a move is owed, the move goes
+        // first and the piece falls on the next clk
+        game_tick  = 1'b1;
+        move_valid = 1'b1;
+        move       = CMD_RIGHT;
+        #1;
+        ok = move_taken;
+        @(negedge clk);
+        game_tick  = 1'b0;
+        move_valid = 1'b0;
+        ok &= piece_is(PIECE_T, ROT_0, 7, 1);
+        @(negedge clk);
+        ok &= piece_is(PIECE_T, ROT_0, 7, 2);
+        check("Test 3", ok);
+
+        // Test 4: a plain gravity tick moves one row
+        game_tick = 1'b1;
+        @(negedge clk);
+        game_tick = 1'b0;
+        @(negedge clk);
+        check("Test 4", piece_is(PIECE_T, ROT_0, 7, 3));
+
+        // Test 5: a hard drop lands (bottom row 1 to 19), locks on the next
+        // clk and the next piece spawns on the clk after. The command behind
+        // it waits out both and goes to the new piece.
+        queued = 2;
+        send(1'b1, CMD_SOFT_DROP);
+        move_valid = 1'b1;
+        move       = CMD_LEFT;
+        #1;
+        ok = piece_is(PIECE_T, ROT_0, 7, 21) && !move_taken && !new_piece_taken;
+        @(negedge clk);
+        ok &= !move_taken && new_piece_taken;
+        ok &= GAME_fixed_state.rows[18] == 10'b0000010000 &&
+              GAME_fixed_state.rows[19] == 10'b0000111000;
+        ok &= column_top[3] == 19 && column_top[4] == 18 && column_top[5] == 19 &&
+              column_top[6] == 20 && lines_cleared == 0;
+        @(negedge clk);
+        ok &= piece_is(PIECE_I, ROT_0, 7, 1) && move_taken;
+        @(negedge clk);
+        move_valid = 1'b0;
+        ok &= piece_is(PIECE_I, ROT_0, 6, 1) && taken_pulses == 2;
+        check("Test 5", ok);
+
+        // Test 6: the I hard drops into columns 6..9 of row 19
+        send_n(CMD_RIGHT, 4);
+        queued = 3;
+        send(1'b1, CMD_SOFT_DROP);
+        repeat (2) @(negedge clk);
+        ok = GAME_fixed_state.rows[19] == 10'b1111111000 && piece_is(PIECE_J, ROT_0, 7, 1);
+        check("Test 6", ok);
+
+        // Test 7: the J moves to the wall and lands in one 20G tick; it
+        // locks after two frames on the ground and clears row 19
+        send_n(CMD_LEFT, 3);
+        game_tick   = 1'b1;
+        gravity_20g = 1'b1;
+        @(negedge clk);
+        game_tick   = 1'b0;
+        gravity_20g = 1'b0;
+        ok = piece_is(PIECE_J, ROT_0, 4, 22);
+        pulse_frame();
+        @(negedge clk);
+        ok &= GAME_fixed_state.rows[19] == 10'b1111111000 && clear_pulses == 0;
+        pulse_frame();
+        @(negedge clk);
+        ok &= clear_valid && clear_count == 1 && lines_cleared == 1;
+        ok &= GAME_fixed_state.rows[18] == '0 && GAME_fixed_state.rows[19] == 10'b0000010001;
+        ok &= column_top[0] == 19 && column_top[1] == 20 && column_top[4] == 19;
+        check("Test 7", ok);
+
+        // Test 8: the queue is empty, so nothing spawns; no game over so far
+        repeat (3) @(negedge clk);
+        check("Test 8", taken_pulses == 3 && clear_pulses == 1 && game_over_pulses == 0 &&
+                        game_over_count == 0);
+
+        $display("=== tb_game_executioner done ===");
+        $finish;
+    end
+
+endmodule
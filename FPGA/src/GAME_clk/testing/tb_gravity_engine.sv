@@ -0,0 +1,120 @@
+// tb_gravity_engine.sv
+// Sanity testbench for gravity_engine: the reset curve at level 0, a
+// rewritten table entry, 20G, level-up from cleared lines, a game over
+// returning to the start level, and the soft drop multiplier. Frames are
+// shortened to 20 clocks.
+
+`timescale 1ns/1ps
+
+import spi_frame_pkg::*;
+
+module tb_gravity_engine;
+
+    logic           clk = 0;
+    logic           reset;
+    logic           v_sync = 1'b1;
+    logic           soft_drop;
+    logic [2:0]     clear_count;
+    logic           clear_valid;
+    logic           game_over;
+    logic [7:0]     config_addr;
+    logic [7:0]     config_data;
+    logic           config_we;
+    logic           frame_tick;
+    logic           game_tick;
+    logic           gravity_20g;
+    logic [4:0]     level;
+
+    gravity_engine dut (.*);
+
+    always #5 clk = ~clk;
+
+    // One frame: v_sync low for 4 clocks, high for 16
+    task automatic frames(input int n);
+        repeat (n) begin
+            v_sync = 1'b0;
+            repeat (4) @(negedge clk);
+            v_sync = 1'b1;
+            repeat (16) @(negedge clk);
+        end
+    endtask
+
+    int ticks;
+    always @(posedge clk) if (game_tick) ticks++;
+
+    task automatic write_config(input logic [7:0] addr, input logic [7:0] data);
+        config_addr = addr;
+        config_data = data;
+        config_we   = 1'b1;
+        @(negedge clk);
+        config_we   = 1'b0;
+    endtask
+
+    task automatic clear(input int rows);
+        clear_count = rows;
+        clear_valid = 1'b1;
+        @(negedge clk);
+        clear_valid = 1'b0;
+    endtask
+
+    task automatic check_ticks(string name, input int frame_count, input int expected);
+        ticks = 0;
+        frames(frame_count);
+        if (ticks !== expected) $error("%s FAILED: %0d ticks in %0d frames, expected %0d", name, ticks, frame_count, expected);
+        else                    $display("%s PASSED", name);
+    endtask
+
+    initial begin
+        $display("=== tb_gravity_engine starting ===");
+
+        reset       = 1'b1;
+        clear_valid = 1'b0;
+        clear_count = '0;
+        game_over   = 1'b0;
+        soft_drop   = 1'b0;
+        config_we   = 1'b0;
+        config_addr = '0;
+        config_data = '0;
+        repeat (4) @(negedge clk);
+        reset = 1'b0;
+
+        // Test 1: level 0 steps every 48 frames
+        check_ticks("Test 1", 96, 2);
+
+        // Test 2: level 0 rewritten to 3 frames per row
+        write_config(CFG_GRAVITY + 0, 8'd3);
+        frames(3);
+        check_ticks("Test 2", 30, 10);
+
+        // Test 3: 20G ticks every frame with gravity_20g
+        write_config(CFG_GRAVITY + 0, 8'd0);
+        check_ticks("Test 3", 10, 10);
+        if (!gravity_20g) $error("Test 3 FAILED: gravity_20g low");
+
+        // Test 4: ten lines reach level 1, which keeps its reset entry
+        write_config(CFG_GRAVITY + 0, 8'd48);
+        clear(4); clear(4); clear(2);
+        if (level !== 5'd1) $error("Test 4 FAILED: level = %0d", level);
+        else                $display("Test 4 PASSED");
+
+        // Test 5: start level applies at once and after a game over
+        write_config(CFG_START_LEVEL, 8'd7);
+        if (level !== 5'd7) $error("Test 5 FAILED: level = %0d", level);
+        clear(4); clear(4); clear(2);
+        game_over = 1'b1;
+        @(negedge clk);
+        game_over = 1'b0;
+        if (level !== 5'd7) $error("Test 5 FAILED: level after game over = %0d", level);
+        else                $display("Test 5 PASSED");
+
+        // Test 6: soft drop at the default factor of 20 on level 0
+        write_config(CFG_START_LEVEL, 8'd0);
+        soft_drop = 1'b1;
+        check_ticks("Test 6", 48, 20);
+        soft_drop = 1'b0;
+
+        $display("=== tb_gravity_engine done ===");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,79 @@
+// tb_landing_finder.sv
+// Sanity testbench for landing_finder: empty board, a stack under one
+// column of the piece, a piece tucked under an overhang (clear below it,
+// and a cell below it), a resting piece, and a fresh spawn above an empty
+// board.
+
+`timescale 1ns/1ps
+
+import game_state_pkg::*;
+import tetris_pkg::*;
+
+module tb_landing_finder;
+
+    bitboard_t          board;
+    active_piece_grid_t active_piece_grid;
+    logic [4:0]         top_row [10];
+    logic [4:0]         drop_rows;
+
+    landing_finder dut (.*);
+
+    // What skyline.sv would hold for this board
+    task automatic check(string name, input int expected);
+        for (int x = 0; x < 10; x++) begin
+            top_row[x] = 20;
+            for (int y = 19; y >= 0; y--) if (board.rows[y][x]) top_row[x] = y;
+        end
+        #1;
+        if (drop_rows !== expected)
+            $error("%s FAILED: drop_rows = %0d, expected %0d", name, drop_rows, expected);
+        else
+            $display("%s PASSED", name);
+    endtask
+
+    initial begin
+        $display("=== tb_landing_finder starting ===");
+
+        // T piece, grid cells (dx,dy): (1,1) (0,2) (1,2) (2,2)
+        // Board cells are (x + dx - 4, y + dy - 4)
+        active_piece_grid       = '{default: '0};
+        active_piece_grid.piece[1][1] = 1'b1;
+        active_piece_grid.piece[0][2] = 1'b1;
+        active_piece_grid.piece[1][2] = 1'b1;
+        active_piece_grid.piece[2][2] = 1'b1;
+        active_piece_grid.x     = 7;    // columns 3..5
+        active_piece_grid.y     = 4;    // bottom cells on row 2
+
+        // Test 1: empty board, bottom cells fall from row 2 to row 19
+        board = blank_bitboard;
+        check("Test 1", 17);
+
+        // Test 2: stack in column 5 up to row 15 stops the right arm at 14
+        for (int y = 15; y < 20; y++) board.rows[y][5] = 1'b1;
+        check("Test 2", 12);
+
+        // Test 3: a cell above the piece in column 4 puts it under an
+        // overhang; column 4 is clear below it, so the stack in column 5
+        // still stops the piece
+        board.rows[0][4] = 1'b1;
+        check("Test 3", 12);
+
+        // Test 3b: a cell below the piece in that column stops it sooner
+        board.rows[5][4] = 1'b1;
+        check("Test 3b", 2);
+
+        // Test 4: resting directly on a cell
+        board = blank_bitboard;
+        board.rows[3][3] = 1'b1;
+        check("Test 4", 0);
+
+        // Test 5: spawned at y = 0, bottom cells on row -2 fall to row 19
+        board = blank_bitboard;
+        active_piece_grid.y = 0;
+        check("Test 5", 21);
+
+        $display("=== tb_landing_finder done ===");
+        $finish;
+    end
+
+endmodule
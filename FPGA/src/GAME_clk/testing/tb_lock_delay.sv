@@ -0,0 +1,123 @@
+// tb_lock_delay.sv
+// Sanity testbench for lock_delay: locks after the configured frames on
+// the ground, moves restart the count up to the reset limit, lifting off
+// restarts it, and a delay of 0 locks at once.
+
+`timescale 1ns/1ps
+
+import spi_frame_pkg::*;
+
+module tb_lock_delay;
+
+    logic       clk = 0;
+    logic       reset;
+    logic       frame_tick;
+    logic       landed;
+    logic       moved;
+    logic       spawn;
+    logic [7:0] config_addr;
+    logic [7:0] config_data;
+    logic       config_we;
+    logic       lock;
+
+    lock_delay dut (.*);
+
+    always #5 clk = ~clk;
+
+    // Frames until lock, or -1 if it has not locked after max_frames frames
+    task automatic frames_to_lock(input int max_frames, output int n);
+        n = -1;
+        for (int f = 0; ; f++) begin
+            if (lock) begin
+                n = f;
+                return;
+            end
+            if (f == max_frames) return;
+            frame_tick = 1'b1;
+            @(negedge clk);
+            frame_tick = 1'b0;
+            repeat (3) @(negedge clk);
+        end
+    endtask
+
+    task automatic pulse_spawn();
+        spawn = 1'b1;
+        @(negedge clk);
+        spawn = 1'b0;
+    endtask
+
+    task automatic pulse_move();
+        moved = 1'b1;
+        @(negedge clk);
+        moved = 1'b0;
+    endtask
+
+    task automatic write_config(input logic [7:0] addr, input logic [7:0] data);
+        config_addr = addr;
+        config_data = data;
+        config_we   = 1'b1;
+        @(negedge clk);
+        config_we   = 1'b0;
+    endtask
+
+    task automatic expect_frames(string name, input int expected, input int n);
+        if (n !== expected) $error("%s FAILED: locked after %0d frames, expected %0d", name, n, expected);
+        else                $display("%s PASSED", name);
+    endtask
+
+    int n;
+
+    initial begin
+        $display("=== tb_lock_delay starting ===");
+
+        reset       = 1'b1;
+        frame_tick  = 1'b0;
+        landed      = 1'b0;
+        moved       = 1'b0;
+        spawn       = 1'b0;
+        config_we   = 1'b0;
+        config_addr = '0;
+        config_data = '0;
+        repeat (2) @(negedge clk);
+        reset = 1'b0;
+
+        write_config(CFG_LOCK_FRAMES, 8'd5);
+        write_config(CFG_LOCK_RESETS, 8'd2);
+
+        // Test 1: lands and locks after 5 frames
+        pulse_spawn();
+        landed = 1'b1;
+        frames_to_lock(20, n);
+        expect_frames("Test 1", 5, n);
+
+        // Test 2: two moves restart the count, the third does not
+        pulse_spawn();
+        frames_to_lock(3, n);
+        pulse_move();
+        frames_to_lock(3, n);
+        pulse_move();
+        frames_to_lock(3, n);
+        pulse_move();
+        frames_to_lock(20, n);
+        expect_frames("Test 2", 2, n);
+
+        // Test 3: lifting off restarts the count
+        pulse_spawn();
+        frames_to_lock(4, n);
+        landed = 1'b0;
+        @(negedge clk);
+        landed = 1'b1;
+        frames_to_lock(20, n);
+        expect_frames("Test 3", 5, n);
+
+        // Test 4: a delay of 0 locks on landing
+        write_config(CFG_LOCK_FRAMES, 8'd0);
+        pulse_spawn();
+        frames_to_lock(20, n);
+        expect_frames("Test 4", 0, n);
+
+        $display("=== tb_lock_delay done ===");
+        $finish;
+    end
+
+endmodule
@@ -148,6 +148,68 @@ module tb_piece_decoder;
 
         print_piece("Test 4: Z, ROT_270", active_piece_grid);
 
+        // --------------------------------------------------------
+        // Test 5: every ROM entry has 4 blocks and is the previous
+        //         rotation turned 90° clockwise about its SRS box
+        //         (3x3 for JLSTZ, 4x4 for I; O stays put)
+        // --------------------------------------------------------
+        begin
+            active_piece_grid_t prev;
+            int errors = 0;
+            int n;
+
+            for (int p = 0; p < 7; p++) begin
+                n = (piece_type_t'(p) == PIECE_I) ? 4 : 3;
+
+                active_piece = '0;
+                active_piece.piece_type = piece_type_t'(p);
+                active_piece.rotation   = ROT_270;
+                #1;
+                prev = active_piece_grid;
+
+                for (int r = 0; r < 4; r++) begin
+                    active_piece.rotation = rotation_t'(r);
+                    #1;
+                    if (count_active_cells(active_piece_grid) != 4) errors++;
+                    for (int x = 0; x < 4; x++)
+                        for (int y = 0; y < 4; y++)
+                            if (piece_type_t'(p) == PIECE_O) begin
+                                if (active_piece_grid.piece[x][y] !== prev.piece[x][y]) errors++;
+                            end else if (x < n && y < n) begin
+                                if (active_piece_grid.piece[x][y] !== prev.piece[y][n-1-x]) errors++;
+                            end else begin
+                                if (active_piece_grid.piece[x][y] !== 1'b0) errors++;
+                            end
+                    prev = active_piece_grid;
+                end
+            end
+
+            assert (errors == 0)
+                else $error("Test 5 FAILED: %0d mismatched cells", errors);
+        end
+
+        // --------------------------------------------------------
+        // Test 6: spawn states match the SRS guideline, e.g. T points
+        //         up and J/L lie flat
+        // --------------------------------------------------------
+        active_piece = '0;
+        active_piece.piece_type = PIECE_T;
+        #1;
+        assert (active_piece_grid.piece[1][0] && active_piece_grid.piece[0][1] &&
+                active_piece_grid.piece[1][1] && active_piece_grid.piece[2][1])
+            else $error("Test 6 FAILED: T spawn state");
+        active_piece.piece_type = PIECE_J;
+        #1;
+        assert (active_piece_grid.piece[0][0] && active_piece_grid.piece[0][1] &&
+                active_piece_grid.piece[1][1] && active_piece_grid.piece[2][1])
+            else $error("Test 6 FAILED: J spawn state");
+        active_piece.piece_type = PIECE_L;
+        active_piece.rotation   = ROT_90;
+        #1;
+        assert (active_piece_grid.piece[1][0] && active_piece_grid.piece[1][1] &&
+                active_piece_grid.piece[1][2] && active_piece_grid.piece[2][2])
+            else $error("Test 6 FAILED: L R state");
+
         $display("=== tb_piece_decoder finished ===");
         $stop; // <--- as requested
     end
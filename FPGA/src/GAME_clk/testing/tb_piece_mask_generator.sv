@@ -12,7 +12,7 @@ module tb_piece_mask_generator;
     localparam int BOARD_HEIGHT = 20;
 
     // DUT I/O
-    game_state_t state;
+    bitboard_t state;
     logic [$clog2(BOARD_WIDTH) -1:0]  piece_x;
     logic [$clog2(BOARD_HEIGHT)-1:0]  piece_y;
     logic [5:0]                       window [5:0];
@@ -77,10 +77,10 @@ module tb_piece_mask_generator;
         // For piece_x=5,piece_y=5:
         //   wx = piece_x + lx - 1 - 4 = lx      (for this choice)
         //   wy = piece_y + ly - 1 - 4 = ly
-        // So window[2][3] should mirror state.screen[2][3].
+        // So window[2][3] should mirror state.rows[3][2].
         // --------------------------------------------------------
         state   = '{default: '0};
-        state.screen[2][3] = 1'b1;
+        state.rows[3][2] = 1'b1;
 
         piece_x = 5;
         piece_y = 5;
@@ -111,15 +111,15 @@ module tb_piece_mask_generator;
         //
         // wy = piece_y + ly - 1 - 4 = 1 + ly - 5 = ly - 4
         //   => for ly=0..3, wy<0 => col_bits[ly] forced to 0
-        //   => for ly=4,5, wy=0,1 sample state.screen[wx][0/1]
+        //   => for ly=4,5, wy=0,1 sample state.rows[0/1][wx]
         // --------------------------------------------------------
         state = '{default: '0};
 
         // Put distinctive bits at (x=0,y=0/1) and (x=1,y=0/1)
-        state.screen[0][0] = 1'b1; // used by window[4][4]
-        state.screen[0][1] = 1'b0; // used by window[4][5]
-        state.screen[1][0] = 1'b1; // used by window[5][4]
-        state.screen[1][1] = 1'b1; // used by window[5][5]
+        state.rows[0][0] = 1'b1; // used by window[4][4]
+        state.rows[1][0] = 1'b0; // used by window[4][5]
+        state.rows[0][1] = 1'b1; // used by window[5][4]
+        state.rows[1][1] = 1'b1; // used by window[5][5]
 
         piece_x = 1;
         piece_y = 1;
@@ -143,16 +143,16 @@ module tb_piece_mask_generator;
 
         // Check some specific sampled cells:
         // lx=4 -> wx=0; ly=4->wy=0; ly=5->wy=1
-        if (window[4][4] !== state.screen[0][0])
-            $error("Test 3 FAILED: window[4][4] != state.screen[0][0]");
-        if (window[4][5] !== state.screen[0][1])
-            $error("Test 3 FAILED: window[4][5] != state.screen[0][1]");
+        if (window[4][4] !== state.rows[0][0])
+            $error("Test 3 FAILED: window[4][4] != state.rows[0][0]");
+        if (window[4][5] !== state.rows[1][0])
+            $error("Test 3 FAILED: window[4][5] != state.rows[1][0]");
 
         // lx=5 -> wx=1; ly=4->wy=0; ly=5->wy=1
-        if (window[5][4] !== state.screen[1][0])
-            $error("Test 3 FAILED: window[5][4] != state.screen[1][0]");
-        if (window[5][5] !== state.screen[1][1])
-            $error("Test 3 FAILED: window[5][5] != state.screen[1][1]");
+        if (window[5][4] !== state.rows[0][1])
+            $error("Test 3 FAILED: window[5][4] != state.rows[0][1]");
+        if (window[5][5] !== state.rows[1][1])
+            $error("Test 3 FAILED: window[5][5] != state.rows[1][1]");
 
         print_window("Test 3: near top-left edge");
 
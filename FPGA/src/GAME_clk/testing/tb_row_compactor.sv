@@ -0,0 +1,79 @@
+// tb_row_compactor.sv
+// Sanity testbench for row_compactor: no clears, a single clear, a
+// Tetris, and split full rows with survivors between them.
+
+`timescale 1ns/1ps
+
+import game_state_pkg::*;
+
+module tb_row_compactor;
+
+    bitboard_t in_state, out_state, expected;
+    logic [4:0]  cleared_count;
+
+    row_compactor dut (.*);
+
+    // Set row y of a board to the 10-bit pattern (bit x = column x)
+    function automatic void set_row(ref bitboard_t s, input int y, input logic [9:0] bits);
+        s.rows[y] = bits;
+    endfunction
+
+    task automatic check(string name, input int count);
+        #1;
+        if (cleared_count !== count)
+            $error("%s FAILED: cleared_count = %0d, expected %0d", name, cleared_count, count);
+        else if (out_state != expected)
+            $error("%s FAILED: board mismatch", name);
+        else
+            $display("%s PASSED", name);
+    endtask
+
+    initial begin
+        $display("=== tb_row_compactor starting ===");
+
+        // Test 1: nothing full, board unchanged
+        in_state = blank_bitboard;
+        set_row(in_state, 19, 10'b0111111111);
+        set_row(in_state, 18, 10'b0000000001);
+        expected = in_state;
+        check("Test 1", 0);
+
+        // Test 2: bottom row full, the row above drops into it
+        in_state = blank_bitboard;
+        set_row(in_state, 19, 10'b1111111111);
+        set_row(in_state, 18, 10'b0000110000);
+        expected = blank_bitboard;
+        set_row(expected, 19, 10'b0000110000);
+        check("Test 2", 1);
+
+        // Test 3: Tetris, four full rows under a partial stack
+        in_state = blank_bitboard;
+        for (int y = 16; y < 20; y++) set_row(in_state, y, 10'b1111111111);
+        set_row(in_state, 15, 10'b1000000001);
+        set_row(in_state, 14, 10'b0000000001);
+        expected = blank_bitboard;
+        set_row(expected, 19, 10'b1000000001);
+        set_row(expected, 18, 10'b0000000001);
+        check("Test 3", 4);
+
+        // Test 4: full rows 19, 17 and 15 with survivors between them
+        in_state = blank_bitboard;
+        set_row(in_state, 19, 10'b1111111111);
+        set_row(in_state, 18, 10'b0000000011);
+        set_row(in_state, 17, 10'b1111111111);
+        set_row(in_state, 16, 10'b0000001100);
+        set_row(in_state, 15, 10'b1111111111);
+        set_row(in_state, 14, 10'b0000110000);
+        set_row(in_state, 0,  10'b1000000000);
+        expected = blank_bitboard;
+        set_row(expected, 19, 10'b0000000011);
+        set_row(expected, 18, 10'b0000001100);
+        set_row(expected, 17, 10'b0000110000);
+        set_row(expected, 3,  10'b1000000000);
+        check("Test 4", 3);
+
+        $display("=== tb_row_compactor done ===");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,113 @@
+// tb_srs_kick.sv
+// Sanity testbench for srs_kick: a free rotation, a rotation blocked at
+// offset 0 that takes the next JLSTZ offset, a board with no room, an
+// O piece that never kicks, and a T-spin triple that needs the last SRS
+// 0->R test.
+
+`timescale 1ns/1ps
+
+import game_state_pkg::*;
+import tetris_pkg::*;
+
+module tb_srs_kick;
+
+    bitboard_t          board;
+    active_piece_t      rotated;
+    active_piece_grid_t rotated_grid;
+
+    piece_type_t        piece_type;
+    rotation_t          rotation;
+    logic [3:0]         piece_x;
+    logic [4:0]         piece_y;
+    logic               kick_ok;
+    logic [3:0]         kick_x;
+    logic [4:0]         kick_y;
+
+    piece_decoder decoder (.active_piece(rotated), .active_piece_grid(rotated_grid));
+
+    srs_kick dut (.board, .piece_type, .rotation, .rotated_piece(rotated_grid.piece),
+                  .piece_x, .piece_y, .kick_ok, .kick_x, .kick_y);
+
+    task automatic setup(input piece_type_t t, input rotation_t r, input int x, input int y);
+        piece_type       = t;
+        rotation         = r;
+        piece_x          = x;
+        piece_y          = y;
+        rotated          = '0;
+        rotated.piece_type = t;
+        rotated.rotation = rotation_t'(r + 1);
+        #1;
+    endtask
+
+    // Fill the board under the rotated piece at (x, y), except cells it
+    // would also cover at (x + skip_dx, y + skip_dy)
+    task automatic block(input int x, input int y, input int skip_dx, input int skip_dy);
+        for (int dx = 0; dx < 4; dx++)
+            for (int dy = 0; dy < 4; dy++)
+                if (rotated_grid.piece[dx][dy]) begin
+                    int sx = dx - skip_dx, sy = dy - skip_dy;
+                    if (!(sx >= 0 && sx < 4 && sy >= 0 && sy < 4 && rotated_grid.piece[sx][sy]))
+                        board.rows[y + dy - 4][x + dx - 4] = 1'b1;
+                end
+        #1;
+    endtask
+
+    task automatic check(string name, input logic ok, input int x, input int y);
+        if (kick_ok !== ok || (ok && (kick_x !== 4'(x) || kick_y !== 5'(y))))
+            $error("%s FAILED: ok=%0b (%0d,%0d), expected ok=%0b (%0d,%0d)",
+                   name, kick_ok, kick_x, kick_y, ok, x, y);
+        else
+            $display("%s PASSED", name);
+    endtask
+
+    initial begin
+        $display("=== tb_srs_kick starting ===");
+
+        // Test 1: T rotates in open space at offset 0
+        board = blank_bitboard;
+        setup(PIECE_T, ROT_0, 7, 10);
+        check("Test 1", 1'b1, 7, 10);
+
+        // Test 2: offset 0 blocked, 0->R's second test is one column left
+        block(7, 10, -1, 0);
+        check("Test 2", 1'b1, 6, 10);
+
+        // Test 3: a full board leaves no offset free
+        for (int y = 0; y < 20; y++) board.rows[y] = '1;
+        #1;
+        check("Test 3", 1'b0, 0, 0);
+
+        // Test 4: O has only offset 0
+        board = blank_bitboard;
+        setup(PIECE_O, ROT_0, 7, 10);
+        check("Test 4a", 1'b1, 7, 10);
+        block(7, 10, -1, 0);
+        check("Test 4b", 1'b0, 0, 0);
+
+        // Test 5: T-spin triple. The T lies flat on row 16 under the
+        // overhang at (3,15); 0->R tests 1-4 are blocked and the fifth,
+        // (-1, +2) in board coordinates, drops it into the slot:
+        //   15 ####......
+        //   16 ###.......
+        //   17 ###.######
+        //   18 ###..#####
+        //   19 ###.######
+        board = blank_bitboard;
+        for (int y = 17; y < 20; y++) board.rows[y] = 10'h3FF;
+        board.rows[17][3] = 1'b0;
+        board.rows[18][3] = 1'b0;
+        board.rows[18][4] = 1'b0;
+        board.rows[19][3] = 1'b0;
+        for (int x = 0; x < 3; x++) begin
+            board.rows[15][x] = 1'b1;
+            board.rows[16][x] = 1'b1;
+        end
+        board.rows[15][3] = 1'b1;
+        setup(PIECE_T, ROT_0, 7, 19);
+        check("Test 5", 1'b1, 6, 21);
+
+        $display("=== tb_srs_kick done ===");
+        $finish;
+    end
+
+endmodule
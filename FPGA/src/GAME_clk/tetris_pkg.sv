@@ -40,8 +40,8 @@ package tetris_pkg;
 
     t.piece_type    = piece;
     t.rotation      = rotation;
-    t.y             = 0;
-    t.x             = 7;
+    t.y             = 1;   // SRS box rows -3..0: spawn shapes sit just above the board
+    t.x             = 7;   // box from column 3, the SRS spawn column
 
     return t;
   endfunction
@@ -212,7 +212,10 @@ module blit_screen_no_telemetry #(
     // Telemetry formatting
     parameter int TELEMETRY_NUM_SIGNALS,
     parameter int TELEMETRY_VALUE_WIDTH,
-    parameter int TELEMETRY_BASE        
+    parameter int TELEMETRY_BASE,
+
+    // Draw frame_B cells as a pixel checkerboard (half brightness)
+    parameter bit DITHER_B = 1'b0
 ) (
     input  logic                               clk,
     input  logic                               reset,
@@ -309,7 +312,8 @@ module blit_screen_no_telemetry #(
 
     assign game_pixel_R = in_game_rect & game_pixel_value_R;
     assign game_pixel_G = in_game_rect & game_pixel_value_G;
-    assign game_pixel_B = in_game_rect & game_pixel_value_B;
+    assign game_pixel_B = in_game_rect & game_pixel_value_B &
+                          (~DITHER_B | (x_idx[0] ^ y_idx[0]));
 
     // Border logic
     assign border_pixel =
@@ -0,0 +1,56 @@
+// command_fifo.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/10/2025
+
+// Queue of game commands between the SPI frame parser and the game logic,
+// both on the same clock. A burst of moves from one frame is held here and
+// handed to the game in order; the game pops the head whenever it applies
+// it, so at most one command is consumed per clock. Commands pushed while
+// the queue is full are dropped and counted.
+
+module command_fifo #(
+    parameter int DEPTH = 8     // power of two
+) (
+    input  logic                        clk,
+    input  logic                        reset,
+
+    // Parser side
+    input  logic                        push,
+    input  spi_frame_pkg::game_cmd_t    push_cmd,
+    output logic [7:0]                  drop_count,     // wrapping
+
+    // Game side
+    output spi_frame_pkg::game_cmd_t    cmd,            // head of the queue
+    output logic                        cmd_valid,
+    input  logic                        cmd_pop
+);
+
+    localparam int PTR_BITS = $clog2(DEPTH);
+
+    spi_frame_pkg::game_cmd_t   queue [DEPTH];
+    logic [PTR_BITS:0]          wr_ptr, rd_ptr;
+    logic                       full;
+
+    assign cmd_valid = (wr_ptr != rd_ptr);
+    assign full      = (wr_ptr[PTR_BITS] != rd_ptr[PTR_BITS]) &
+                       (wr_ptr[PTR_BITS-1:0] == rd_ptr[PTR_BITS-1:0]);
+    assign cmd       = queue[rd_ptr[PTR_BITS-1:0]];
+
+    always_ff @(posedge clk) begin
+        if (push & ~full) queue[wr_ptr[PTR_BITS-1:0]] <= push_cmd;
+    end
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            wr_ptr     <= '0;
+            rd_ptr     <= '0;
+            drop_count <= '0;
+        end else begin
+            if (push & ~full)        wr_ptr     <= wr_ptr + 1;
+            if (push &  full)        drop_count <= drop_count + 1;
+            if (cmd_pop & cmd_valid) rd_ptr     <= rd_ptr + 1;
+        end
+    end
+
+endmodule
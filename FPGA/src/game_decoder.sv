@@ -18,7 +18,8 @@ module game_decoder #(
 
     input   game_state_pkg::game_state_t        VGA_frame,
 
-    // 6 debug windows, each 3-color 6x6
+    // 6 side windows, each 3-color 6x6: the hold slot (0) and the
+    // next-piece queue (1..5, next first)
     input   logic [5:0]                         debug_window_0 [COLORS][5:0],
     input   logic [5:0]                         debug_window_1 [COLORS][5:0],
     input   logic [5:0]                         debug_window_2 [COLORS][5:0],
@@ -108,13 +109,15 @@ module game_decoder #(
         .TELEMETRY_BASE        (TELEMETRY_BASE),
         // Frame size for the main game board
         .FRAME_WIDTH           (10),
-        .FRAME_HEIGHT          (20)
+        .FRAME_HEIGHT          (20),
+        // Ghost piece is drawn dithered so it reads as a shadow
+        .DITHER_B              (1'b1)
     ) u_main_panel (
         .clk                 (clk),
         .reset               (reset),
         .frame_R             (VGA_frame.screen),
-        .frame_G             (),
-        .frame_B             (),
+        .frame_G             (game_state_pkg::blank_game_state.screen),
+        .frame_B             (VGA_frame.ghost),  // ghost piece: dithered blue
         .pixel_x_target_next (pixel_x_target_next),
         .pixel_y_target_next (pixel_y_target_next),
         .telemetry_values    (telemetry_values),
@@ -157,18 +160,20 @@ module game_decoder #(
     )
 
     // ------------------------------------------------------------
-    // 3 mini panels on the left (indices 1Ã¢â‚¬â€œ3)
+    // 3 mini panels on the left (indices 1Ã¢â‚¬â€œ3): hold on top, then
+    // the last two queue entries
     // ------------------------------------------------------------
-    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_L0, 1, LEFT_X0,  MINI_Y0_1, debug_window_0, debug_singals_0);
-    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_L1, 2, LEFT_X0,  MINI_Y0_2, debug_window_1, debug_singals_1);
-    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_L2, 3, RIGHT_X0,  MINI_Y0_1, debug_window_2, debug_singals_2);
+    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_L0, 1, LEFT_X0,  MINI_Y0_0, debug_window_0, debug_singals_0);
+    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_L1, 2, LEFT_X0,  MINI_Y0_1, debug_window_4, debug_singals_1);
+    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_L2, 3, LEFT_X0,  MINI_Y0_2, debug_window_5, debug_singals_2);
 
     // ------------------------------------------------------------
-    // 3 mini panels on the right (indices 4Ã¢â‚¬â€œ6)
+    // 3 mini panels on the right (indices 4Ã¢â‚¬â€œ6): next three pieces,
+    // next at the top
     // ------------------------------------------------------------
-    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_R0, 4, RIGHT_X0, MINI_Y0_2, debug_window_3, debug_singals_3);
-    // `INSTANTIATE_DEBUG_PANEL(u_mini_panel_R1, 5, RIGHT_X0, MINI_Y0_0, debug_window_4, debug_singals_4);
-    // `INSTANTIATE_DEBUG_PANEL(u_mini_panel_R2, 6, RIGHT_X0, MINI_Y0_2, debug_window_5, debug_singals_5);
+    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_R0, 4, RIGHT_X0, MINI_Y0_0, debug_window_1, debug_singals_3);
+    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_R1, 5, RIGHT_X0, MINI_Y0_1, debug_window_2, debug_singals_4);
+    `INSTANTIATE_DEBUG_PANEL(u_mini_panel_R2, 6, RIGHT_X0, MINI_Y0_2, debug_window_3, debug_singals_5);
 
 `undef INSTANTIATE_DEBUG_PANEL
 
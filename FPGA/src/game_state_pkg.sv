@@ -8,8 +8,41 @@ package game_state_pkg;
   typedef struct {
     // screen[x][y] : 20 rows, each 10 bits wide
     logic [19:0] screen [9:0];
+    // ghost[x][y] : where the active piece would land (never over screen cells)
+    logic [19:0] ghost  [9:0];
   } game_state_t;
 
   localparam game_state_t blank_game_state = '{default: '0};
 
+  // Row-major bitboard used by the game logic: rows[y] holds row y (0 is
+  // the top), bit x is column x. A full row is &rows[y] and a line clear
+  // is a row move. game_state_t stays the frame format for the VGA side.
+  localparam int BOARD_WIDTH  = 10;
+  localparam int BOARD_HEIGHT = 20;
+
+  typedef logic [BOARD_WIDTH-1:0] board_row_t;
+
+  typedef struct {
+    board_row_t rows [BOARD_HEIGHT];
+  } bitboard_t;
+
+  localparam bitboard_t blank_bitboard = '{default: '0};
+
+  function automatic bitboard_t to_bitboard(game_state_t state);
+    bitboard_t board;
+    for (int y = 0; y < BOARD_HEIGHT; y++)
+      for (int x = 0; x < BOARD_WIDTH; x++)
+        board.rows[y][x] = state.screen[x][y];
+    return board;
+  endfunction
+
+  function automatic game_state_t to_game_state(bitboard_t board);
+    game_state_t state;
+    state = blank_game_state;
+    for (int x = 0; x < BOARD_WIDTH; x++)
+      for (int y = 0; y < BOARD_HEIGHT; y++)
+        state.screen[x][y] = board.rows[y][x];
+    return state;
+  endfunction
+
 endpackage : game_state_pkg
\ No newline at end of file
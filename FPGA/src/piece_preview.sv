@@ -0,0 +1,51 @@
+// piece_preview.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/14/2025
+
+// Draws one piece, spawn orientation, in the middle of a 6x6 mini-panel
+// window, in a color per piece type. An invalid slot draws nothing.
+
+`define COLORS 3
+
+module piece_preview (
+    input  tetris_pkg::piece_type_t     piece_type,
+    input  logic                        valid,
+    output logic [5:0]                  window [`COLORS][5:0]
+);
+
+    import tetris_pkg::*;
+
+    active_piece_t      piece;
+    active_piece_grid_t piece_grid;
+    logic [2:0]         color;      // {B, G, R}
+
+    assign piece = make_piece(piece_type, ROT_0);
+
+    piece_decoder Piece_Decoder(.active_piece(piece), .active_piece_grid(piece_grid));
+
+    always_comb begin
+        unique case (piece_type)
+            PIECE_I: color = 3'b110;    // cyan
+            PIECE_O: color = 3'b011;    // yellow
+            PIECE_T: color = 3'b101;    // magenta
+            PIECE_S: color = 3'b010;    // green
+            PIECE_Z: color = 3'b001;    // red
+            PIECE_J: color = 3'b100;    // blue
+            default: color = 3'b111;    // L: white
+        endcase
+
+        // 4x4 grid -> window cells 1..4, window[color][x][y]
+        for (int c = 0; c < `COLORS; c++) begin
+            for (int x = 0; x < 6; x++) begin
+                window[c][x] = '0;
+            end
+            for (int x = 0; x < 4; x++) begin
+                for (int y = 0; y < 4; y++) begin
+                    window[c][x+1][y+1] = valid & color[c] & piece_grid.piece[x][y];
+                end
+            end
+        end
+    end
+
+endmodule
@@ -1,73 +1,118 @@
 // Game Decoder
-// James Kaden Cassidy 
+// James Kaden Cassidy
 // kacassidy@hmc.edu
 // 11/12/2025
 
+// SPI byte receiver (mode 0). The shift register runs directly on sck, so
+// the link speed is not limited by oversampling in the system clock;
+// complete words cross into clk through a gray-coded async FIFO together
+// with a flag marking the first word after ce rises, so a frame parser can
+// find frame boundaries. On the clk side each word comes out as a
+// one-cycle data_valid strobe whenever data_ready is high.
+//
+// Full duplex: tx_data is shifted out on sdo, MSB first, changing on
+// falling sck edges. A clk-domain shadow copy follows tx_data while ce is
+// low and freezes once ce is seen high; the MCU leaves well over two clk
+// periods between raising ce and its first sck edge. Bits past the end of
+// tx_data read as 0.
 
 module spi #(
-    parameter int WIDTH = 8
+    parameter int WIDTH      = 8,
+    parameter int TX_BYTES   = 1,
+    parameter int FIFO_DEPTH = 8
 ) (
-    input  logic              reset,   // async reset, active high
+    input  logic              reset,      // active high
     input  logic              clk,
-    input  logic              sck,     // SPI clock
-    input  logic              sdi,     // serial data in
-    output logic              sdo,     // serial data out (MSB)
-    input  logic              ce,      // chip enable, active high
-    input  logic              clear,   // pulse to clear data_valid
-    output logic [WIDTH-1:0]  data,    // last completed word
-    output logic              data_valid
+    input  logic              sck,        // SPI clock
+    input  logic              sdi,        // serial data in
+    output logic              sdo,        // serial data out (MSB)
+    input  logic              ce,         // chip enable, active high
+    output logic [WIDTH-1:0]  data,       // last completed word
+    output logic              data_valid, // one-cycle strobe per word
+    output logic              data_first, // data is the first word of this ce
+    input  logic              data_ready, // consumer can take a word this cycle
+    input  logic [TX_BYTES*8-1:0] tx_data // sent back during each transaction
 );
 
-    logic             ce_q;  // previous value of ce in sck domain
-    logic             synced_sclk;
+    localparam int COUNT_BITS = $clog2(WIDTH);
+    localparam int TX_BITS    = TX_BYTES * 8;
+    localparam int TX_IDX_BITS = $clog2(TX_BITS + 1);
 
-    logic [WIDTH:0] shift_reg;
-    //logic [WIDTH-1:0] shift_reg;
-    synchronizer #(
-        .bits(1)
-    ) Sclk_sync (
-        .clk               (clk),
-        .raw_input         (sck),
-        .synchronized_value(synced_sclk)
-    );
-    
-    always_ff @(posedge synced_sclk) begin
-        if (reset) begin
-             shift_reg  <= 0;
-             ce_q       <= 1'b0;
+    // ------------------------------------------------------------
+    // sck domain: everything restarts while ce is low
+    // ------------------------------------------------------------
+    logic [WIDTH-2:0]       shift_reg;
+    logic [COUNT_BITS-1:0]  bit_count;
+    logic                   first_pending;  // no word completed yet this ce
+    logic                   word_done;
+    logic [WIDTH-1:0]       word;
+
+    assign word_done = (bit_count == COUNT_BITS'(WIDTH - 1));
+    assign word      = {shift_reg, sdi};
+
+    always_ff @(posedge sck or negedge ce) begin
+        if (~ce) begin
+            shift_reg     <= '0;
+            bit_count     <= '0;
+            first_pending <= 1'b1;
         end else begin
-            if (ce) shift_reg[WIDTH:0] <= {shift_reg[WIDTH-1:0], sdi}; //shift_reg[WIDTH-1:0] <= {shift_reg[WIDTH-2:0], sdi};
-            // remember previous CE to detect edge
-            ce_q <= ce;
+            shift_reg <= word[WIDTH-2:0];
+            bit_count <= bit_count + 1;     // wraps to 0 after each word
+            if (word_done) first_pending <= 1'b0;
         end
     end
 
-    logic new_transaction;
+    // The last bit of a word and the FIFO write share the same sck edge
+    logic rx_empty;
+    logic [WIDTH:0] rx_entry;
 
+    async_fifo #(
+        .WIDTH (WIDTH + 1),
+        .DEPTH (FIFO_DEPTH)
+    ) Rx_fifo (
+        .wclk   (sck),
+        .wreset (reset),
+        .winc   (ce & word_done),
+        .wdata  ({first_pending, word}),
+        .wfull  (),                 // clk drains it far faster than sck fills it
+        .rclk   (clk),
+        .rreset (reset),
+        .rinc   (data_ready & ~rx_empty),
+        .rdata  (rx_entry),
+        .rempty (rx_empty)
+    );
+
+    // ------------------------------------------------------------
+    // clk domain: hand words to the consumer
+    // ------------------------------------------------------------
     always_ff @(posedge clk) begin
         if (reset) begin
-            //data       <= '0;
             data_valid <= 1'b0;
-            new_transaction <= 1'b0;
         end else begin
-        // detect CE de-assert (1 -> 0) and latch new data
-            if (ce) begin
-                new_transaction <= 1'b1;
+            data_valid <= data_ready & ~rx_empty;
+            if (data_ready & ~rx_empty) begin
+                {data_first, data} <= rx_entry;
             end
-            // "chip de_enables" in your wording
-            if (ce_q & ~ce & new_transaction) begin
-                //data       <= shift_reg[WIDTH:1];
-                data       <= shift_reg[WIDTH-1:0];
-                data_valid <= 1'b1;
+        end
+    end
 
-                new_transaction <= 1'b0;
-            end
+    // ------------------------------------------------------------
+    // Transmit: shadow in clk, bit select on falling sck
+    // ------------------------------------------------------------
+    logic [1:0]             ce_sync;
+    logic [TX_BITS-1:0]     tx_shadow;
+    logic [TX_IDX_BITS-1:0] tx_index;
 
-            // external logic can clear the valid flag
-            if (clear) begin
-                data_valid <= 1'b0;
-            end
-        end
+    always_ff @(posedge clk) begin
+        ce_sync <= {ce_sync[0], ce};
+        if (~ce_sync[1]) tx_shadow <= tx_data;
     end
 
+    always_ff @(negedge sck or negedge ce) begin
+        if (~ce)                            tx_index <= '0;
+        else if (tx_index != TX_BITS)       tx_index <= tx_index + 1;
+    end
+
+    assign sdo = (tx_index < TX_BITS) ? tx_shadow[TX_BITS - 1 - tx_index] : 1'b0;
+
 endmodule
@@ -0,0 +1,206 @@
+// spi_frame_parser.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/8/2025
+
+// Parses the framed SPI protocol (see spi_frame_pkg) from the byte stream
+// of spi.sv. A frame is buffered until its CRC checks out, then its opcodes
+// are executed one per clock:
+//   OP_MOVE / OP_HARD_DROP /
+//   OP_HOLD                 -> cmd, cmd_push strobe (into command_fifo)
+//   OP_PIECE_RNG            -> piece_rng
+//   OP_SOFT_DROP            -> soft_drop, held until the release message
+//   OP_SEED                 -> seed, seed_valid strobe
+//   OP_CONFIG               -> config_addr / config_data, config_we strobe
+// Bad CRCs, sequence gaps and malformed frames are counted, never executed.
+// Bytes after the CRC and before the next frame are padding and ignored.
+// byte_ready holds the byte stream back while a frame executes.
+
+module spi_frame_parser (
+    input  logic                        clk,
+    input  logic                        reset,
+
+    // Byte stream from spi.sv
+    input  logic [7:0]                  byte_data,
+    input  logic                        byte_valid,
+    input  logic                        byte_first,
+    output logic                        byte_ready,  // low while a frame executes
+
+    // Game commands
+    output spi_frame_pkg::game_cmd_t    cmd,
+    output logic                        cmd_push,
+
+    // Registers written by frames
+    output logic [2:0]                  piece_rng,
+    output logic                        soft_drop,
+    output logic [31:0]                 seed,
+    output logic                        seed_valid,
+    output logic [7:0]                  config_addr,
+    output logic [7:0]                  config_data,
+    output logic                        config_we,
+
+    // Link health (wrapping counters)
+    output logic [7:0]                  frame_count,     // good frames
+    output logic [7:0]                  crc_error_count,
+    output logic [7:0]                  missed_count,    // frames lost per sequence gaps
+    output logic [7:0]                  malformed_count  // bad header/length/opcode, truncated
+);
+
+    import spi_frame_pkg::*;
+
+    localparam int LEN_BITS = $clog2(MAX_PAYLOAD + 1);
+    localparam int IDX_BITS = $clog2(MAX_PAYLOAD);
+
+    typedef enum logic [2:0] {
+        S_IDLE,     // waiting for the first byte of a frame
+        S_SEQ,
+        S_LEN,
+        S_PAYLOAD,
+        S_CRC,
+        S_EXEC,     // frame accepted, running its opcodes
+        S_DISCARD   // bad frame, ignore bytes until the next one starts
+    } state_t;
+
+    state_t                 state;
+    logic [7:0]             crc;
+    logic [7:0]             seq;
+    logic [7:0]             last_seq;
+    logic                   have_seq;
+    logic [LEN_BITS-1:0]    len;
+    logic [LEN_BITS-1:0]    ptr;
+    logic [7:0]             payload [MAX_PAYLOAD];
+
+    // Bytes wait in the spi.sv FIFO while a frame executes
+    assign byte_ready = (state != S_EXEC);
+
+    // Current opcode during S_EXEC
+    logic [7:0]             op;
+    logic [7:0]             op_len;
+    logic [7:0]             arg [4];
+
+    always_comb begin
+        op     = payload[IDX_BITS'(ptr)];
+        op_len = op_arg_len(op);
+        for (int i = 0; i < 4; i++) begin
+            arg[i] = payload[IDX_BITS'(ptr + 1 + i)];
+        end
+    end
+
+    // ------------------------------------------------------------
+    // Frame state machine
+    // ------------------------------------------------------------
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            state           <= S_IDLE;
+            have_seq        <= 1'b0;
+            last_seq        <= '0;
+            piece_rng       <= '0;
+            soft_drop       <= 1'b0;
+            seed            <= '0;
+            seed_valid      <= 1'b0;
+            config_we       <= 1'b0;
+            cmd_push        <= 1'b0;
+            frame_count     <= '0;
+            crc_error_count <= '0;
+            missed_count    <= '0;
+            malformed_count <= '0;
+        end else begin
+            seed_valid <= 1'b0;
+            config_we  <= 1'b0;
+            cmd_push   <= 1'b0;
+
+            if (state == S_EXEC) begin
+                if (ptr >= len) begin
+                    state <= S_IDLE;
+                end else if (op_len == BAD_OPCODE || ptr + 1 + op_len > len) begin
+                    malformed_count <= malformed_count + 1;
+                    state           <= S_IDLE;
+                end else begin
+                    unique case (op)
+                        OP_MOVE: begin
+                            cmd_push <= 1'b1;
+                            cmd      <= '{hold: 1'b0, hard_drop: 1'b0, move: tetris_pkg::command_t'(arg[0][1:0])};
+                        end
+                        OP_HARD_DROP: begin
+                            cmd_push <= 1'b1;
+                            cmd      <= '{hold: 1'b0, hard_drop: 1'b1, move: tetris_pkg::CMD_SOFT_DROP};
+                        end
+                        OP_HOLD: begin
+                            cmd_push <= 1'b1;
+                            cmd      <= '{hold: 1'b1, hard_drop: 1'b0, move: tetris_pkg::CMD_SOFT_DROP};
+                        end
+                        OP_PIECE_RNG: piece_rng <= arg[0][2:0];
+                        OP_SOFT_DROP: soft_drop <= arg[0][0];
+                        OP_SEED: begin
+                            seed       <= {arg[3], arg[2], arg[1], arg[0]};
+                            seed_valid <= 1'b1;
+                        end
+                        OP_CONFIG: begin
+                            config_addr <= arg[0];
+                            config_data <= arg[1];
+                            config_we   <= 1'b1;
+                        end
+                        default: ;  // OP_NOP
+                    endcase
+                    ptr <= ptr + 1 + LEN_BITS'(op_len);
+                end
+            end else if (byte_valid) begin
+                // A new frame always restarts the parser; one cut short is malformed
+                if (byte_first) begin
+                    if (state != S_IDLE && state != S_DISCARD) begin
+                        malformed_count <= malformed_count + 1;
+                    end
+                    crc <= crc8(8'h00, byte_data);
+                    if (byte_data[7:4] == VERSION) begin
+                        state <= S_SEQ;
+                    end else begin
+                        malformed_count <= malformed_count + 1;
+                        state           <= S_DISCARD;
+                    end
+                end else begin
+                    crc <= crc8(crc, byte_data);
+
+                    unique case (state)
+                        S_SEQ: begin
+                            seq   <= byte_data;
+                            state <= S_LEN;
+                        end
+                        S_LEN: begin
+                            len <= LEN_BITS'(byte_data);
+                            ptr <= '0;
+                            if (byte_data > MAX_PAYLOAD) begin
+                                malformed_count <= malformed_count + 1;
+                                state           <= S_DISCARD;
+                            end else begin
+                                state <= (byte_data == 0) ? S_CRC : S_PAYLOAD;
+                            end
+                        end
+                        S_PAYLOAD: begin
+                            payload[IDX_BITS'(ptr)] <= byte_data;
+                            ptr <= ptr + 1;
+                            if (ptr + 1 == len) state <= S_CRC;
+                        end
+                        S_CRC: begin
+                            ptr <= '0;
+                            if (byte_data == crc) begin
+                                // Frames between last_seq and seq never arrived
+                                if (have_seq && seq != last_seq + 8'd1) begin
+                                    missed_count <= missed_count + (seq - last_seq - 8'd1);
+                                end
+                                last_seq    <= seq;
+                                have_seq    <= 1'b1;
+                                frame_count <= frame_count + 1;
+                                state       <= S_EXEC;
+                            end else begin
+                                crc_error_count <= crc_error_count + 1;
+                                state           <= S_DISCARD;
+                            end
+                        end
+                        default: ;  // S_IDLE: padding after a frame, S_DISCARD
+                    endcase
+                end
+            end
+        end
+    end
+
+endmodule
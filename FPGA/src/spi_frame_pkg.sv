@@ -0,0 +1,96 @@
+// spi_frame_pkg.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/8/2025
+
+// Framed MCU -> FPGA SPI protocol. One frame per chip-enable:
+//
+//   byte 0      : {version[3:0], flags[3:0]}   (flags reserved, send 0)
+//   byte 1      : sequence number, +1 per frame (mod 256)
+//   byte 2      : payload length in bytes (0..MAX_PAYLOAD)
+//   payload     : opcodes, each followed by op_arg_len(opcode) argument bytes
+//   last byte   : CRC-8 (poly 0x07, init 0x00) over bytes 0 .. end of payload
+//
+// While a frame is clocked in, the FPGA shifts a status frame out on sdo
+// (STATUS_BYTES bytes, laid out by the ST_* offsets below, last byte a
+// CRC-8 over the rest). The MCU pads short frames with 0x00 so every
+// transfer is at least STATUS_BYTES long; padding after a frame is ignored.
+//
+// Must match MCU/spi_protocol.h.
+
+package spi_frame_pkg;
+
+  localparam logic [3:0] VERSION      = 4'd1;
+  localparam int         MAX_PAYLOAD  = 16;
+
+  typedef enum logic [7:0] {
+    OP_NOP        = 8'h00,  // no arguments
+    OP_MOVE       = 8'h01,  // arg: tetris_pkg::command_t in bits 1..0
+    OP_HARD_DROP  = 8'h02,  // no arguments
+    OP_PIECE_RNG  = 8'h03,  // arg: random piece value 0..6 (unused, see bag_randomizer)
+    OP_SEED       = 8'h04,  // args: 32-bit seed, little endian
+    OP_CONFIG     = 8'h05,  // args: register, value
+    OP_HOLD       = 8'h06,  // no arguments
+    OP_SOFT_DROP  = 8'h07   // arg: 1 key pressed, 0 released
+  } opcode_t;
+
+  localparam logic [7:0] BAD_OPCODE = 8'hFF;
+
+  // OP_CONFIG registers
+  localparam int         GRAVITY_LEVELS      = 32;
+  localparam logic [7:0] CFG_GRAVITY         = 8'h00;  // + level: frames per row, 0 = 20G
+  localparam logic [7:0] CFG_LINES_PER_LEVEL = 8'h20;  // lines to the next level (0 = 1)
+  localparam logic [7:0] CFG_START_LEVEL     = 8'h21;  // level after a game over; also applied at once
+  localparam logic [7:0] CFG_LOCK_FRAMES     = 8'h22;  // frames a landed piece waits before locking
+  localparam logic [7:0] CFG_LOCK_RESETS     = 8'h23;  // moves per piece that restart the lock delay
+  localparam logic [7:0] CFG_SOFT_DROP       = 8'h24;  // gravity multiplier while soft drop is held (0 = 1)
+
+  // Status frame, FPGA -> MCU
+  localparam logic [3:0] STATUS_VERSION = 4'd1;
+  localparam int         STATUS_BYTES   = 21;
+
+  localparam int ST_HEADER      = 0;   // {STATUS_VERSION, 4'b0}
+  localparam int ST_PIECE       = 1;   // {2'b0, rotation, 1'b0, piece_type}
+  localparam int ST_PIECE_X     = 2;
+  localparam int ST_PIECE_Y     = 3;
+  localparam int ST_LINES       = 4;   // lines cleared, 16-bit little endian
+  localparam int ST_HEIGHTS     = 6;   // 10 column heights, 0..20, column 0 first
+  localparam int ST_GAME_OVERS  = 16;
+  localparam int ST_CMD_DROPS   = 17;  // commands lost to a full command queue
+  localparam int ST_CRC_ERRORS  = 18;
+  localparam int ST_MISSED      = 19;
+  localparam int ST_CRC         = 20;
+
+  // Number of argument bytes after an opcode, BAD_OPCODE if unknown
+  function automatic logic [7:0] op_arg_len(logic [7:0] op);
+    case (op)
+      OP_NOP:       return 8'd0;
+      OP_MOVE:      return 8'd1;
+      OP_HARD_DROP: return 8'd0;
+      OP_PIECE_RNG: return 8'd1;
+      OP_SEED:      return 8'd4;
+      OP_CONFIG:    return 8'd2;
+      OP_HOLD:      return 8'd0;
+      OP_SOFT_DROP: return 8'd1;
+      default:      return BAD_OPCODE;
+    endcase
+  endfunction
+
+  // CRC-8, polynomial x^8 + x^2 + x + 1, MSB first
+  function automatic logic [7:0] crc8(logic [7:0] crc, logic [7:0] data);
+    logic [7:0] c;
+    c = crc ^ data;
+    for (int i = 0; i < 8; i++) begin
+      c = c[7] ? ((c << 1) ^ 8'h07) : (c << 1);
+    end
+    return c;
+  endfunction
+
+  // One game command handed from the frame parser to game_executioner
+  typedef struct packed {
+    logic                 hold;         // swap the active piece with the hold slot
+    logic                 hard_drop;
+    tetris_pkg::command_t move;
+  } game_cmd_t;
+
+endpackage : spi_frame_pkg
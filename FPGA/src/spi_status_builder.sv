@@ -0,0 +1,85 @@
+// spi_status_builder.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/8/2025
+
+// Packs game and link state into the status frame spi.sv shifts back to the
+// MCU (layout in spi_frame_pkg). Column heights come straight from the
+// game's skyline registers. The game state is registered once on the way
+// in to keep the CRC tree off the game logic's paths; the frame is
+// rebuilt every cycle and spi.sv samples it when ce rises, so the MCU sees a
+// snapshot taken at the start of its transaction.
+
+module spi_status_builder (
+    input  logic                            clk,
+
+    // Game state
+    input  logic [4:0]                      column_top [10],  // skyline, 20 = empty
+    input  tetris_pkg::active_piece_t       active_piece,
+    input  logic [15:0]                     lines_cleared,
+    input  logic [7:0]                      game_over_count,
+
+    // Link counters
+    input  logic [7:0]                      cmd_drop_count,
+    input  logic [7:0]                      crc_error_count,
+    input  logic [7:0]                      missed_count,
+
+    output logic [spi_frame_pkg::STATUS_BYTES*8-1:0] status
+);
+
+    import spi_frame_pkg::*;
+
+    localparam int BOARD_WIDTH  = 10;
+    localparam int BOARD_HEIGHT = 20;
+
+    // ------------------------------------------------------------
+    // Register the game state
+    // ------------------------------------------------------------
+    logic [4:0]                 top_row [BOARD_WIDTH];
+    tetris_pkg::active_piece_t  piece;
+    logic [15:0]                lines;
+    logic [7:0]                 game_overs;
+
+    always_ff @(posedge clk) begin
+        top_row    <= column_top;
+        piece      <= active_piece;
+        lines      <= lines_cleared;
+        game_overs <= game_over_count;
+    end
+
+    // ------------------------------------------------------------
+    // Assemble the frame
+    // ------------------------------------------------------------
+    logic [7:0] bytes [STATUS_BYTES];
+    logic [7:0] crc;
+
+    always_comb begin
+        bytes[ST_HEADER]     = {STATUS_VERSION, 4'b0};
+        bytes[ST_PIECE]      = {2'b0, piece.rotation, 1'b0, piece.piece_type};
+        bytes[ST_PIECE_X]    = 8'(piece.x);
+        bytes[ST_PIECE_Y]    = 8'(piece.y);
+        bytes[ST_LINES]      = lines[7:0];
+        bytes[ST_LINES + 1]  = lines[15:8];
+        for (int x = 0; x < BOARD_WIDTH; x++) begin
+            bytes[ST_HEIGHTS + x] = 8'(BOARD_HEIGHT - top_row[x]);
+        end
+        bytes[ST_GAME_OVERS] = game_overs;
+        bytes[ST_CMD_DROPS]  = cmd_drop_count;
+        bytes[ST_CRC_ERRORS] = crc_error_count;
+        bytes[ST_MISSED]     = missed_count;
+
+        crc = 8'h00;
+        for (int i = 0; i < ST_CRC; i++) begin
+            crc = crc8(crc, bytes[i]);
+        end
+        bytes[ST_CRC] = crc;
+    end
+
+    // Byte 0 goes out first
+    always_ff @(posedge clk) begin
+        for (int i = 0; i < STATUS_BYTES; i++) begin
+            status[(STATUS_BYTES-1-i)*8 +: 8] <= bytes[i];
+        end
+    end
+
+endmodule
@@ -0,0 +1,106 @@
+// async_fifo.sv
+// James Kaden Cassidy
+// kacassidy@hmc.edu
+// 12/9/2025
+
+// Dual-clock FIFO. Each side keeps a binary pointer for addressing and a
+// gray-coded copy that the other side brings across with a synchronizer,
+// so only one bit of a crossing pointer ever changes at a time. Full and
+// empty are computed against the synchronized (slightly stale) pointer of
+// the other side, which can only make them pessimistic, never wrong.
+//
+// Resets are asynchronous because the write clock may be an external clock
+// (e.g. SPI sck) that is not running while reset is asserted.
+
+module async_fifo #(
+    parameter int WIDTH = 8,
+    parameter int DEPTH = 8     // power of two, at least 4
+) (
+    // Write side
+    input  logic                wclk,
+    input  logic                wreset,
+    input  logic                winc,
+    input  logic [WIDTH-1:0]    wdata,
+    output logic                wfull,
+
+    // Read side
+    input  logic                rclk,
+    input  logic                rreset,
+    input  logic                rinc,
+    output logic [WIDTH-1:0]    rdata,
+    output logic                rempty
+);
+
+    localparam int ADDR_BITS = $clog2(DEPTH);
+
+    logic [WIDTH-1:0]       mem [DEPTH];
+
+    logic [ADDR_BITS:0]     wbin, wgray, wbin_next, wgray_next;
+    logic [ADDR_BITS:0]     rbin, rgray, rbin_next, rgray_next;
+    logic [ADDR_BITS:0]     wgray_rsync;    // write pointer seen by the reader
+    logic [ADDR_BITS:0]     rgray_wsync;    // read pointer seen by the writer
+
+    function automatic logic [ADDR_BITS:0] bin2gray(logic [ADDR_BITS:0] b);
+        return b ^ (b >> 1);
+    endfunction
+
+    // ------------------------------------------------------------
+    // Write side
+    // ------------------------------------------------------------
+    assign wbin_next  = wbin + (winc & ~wfull);
+    assign wgray_next = bin2gray(wbin_next);
+
+    always_ff @(posedge wclk) begin
+        if (winc & ~wfull) mem[wbin[ADDR_BITS-1:0]] <= wdata;
+    end
+
+    always_ff @(posedge wclk or posedge wreset) begin
+        if (wreset) begin
+            wbin  <= '0;
+            wgray <= '0;
+            wfull <= 1'b0;
+        end else begin
+            wbin  <= wbin_next;
+            wgray <= wgray_next;
+            // Full: reader is exactly one lap behind (top two gray bits differ)
+            wfull <= (wgray_next == {~rgray_wsync[ADDR_BITS:ADDR_BITS-1],
+                                      rgray_wsync[ADDR_BITS-2:0]});
+        end
+    end
+
+    synchronizer #(
+        .bits(ADDR_BITS + 1)
+    ) Rptr_sync (
+        .clk               (wclk),
+        .raw_input         (rgray),
+        .synchronized_value(rgray_wsync)
+    );
+
+    // ------------------------------------------------------------
+    // Read side
+    // ------------------------------------------------------------
+    assign rbin_next  = rbin + (rinc & ~rempty);
+    assign rgray_next = bin2gray(rbin_next);
+    assign rdata      = mem[rbin[ADDR_BITS-1:0]];
+
+    always_ff @(posedge rclk or posedge rreset) begin
+        if (rreset) begin
+            rbin   <= '0;
+            rgray  <= '0;
+            rempty <= 1'b1;
+        end else begin
+            rbin   <= rbin_next;
+            rgray  <= rgray_next;
+            rempty <= (rgray_next == wgray_rsync);
+        end
+    end
+
+    synchronizer #(
+        .bits(ADDR_BITS + 1)
+    ) Wptr_sync (
+        .clk               (rclk),
+        .raw_input         (wgray),
+        .synchronized_value(wgray_rsync)
+    );
+
+endmodule
@@ -0,0 +1,134 @@
+// tb_spi_frame_parser.sv
+// Sanity testbench for spi_frame_parser: good frames, bad CRC, sequence
+// gaps and a bad version, fed straight in as a byte stream.
+
+`timescale 1ns/1ps
+
+import spi_frame_pkg::*;
+
+module tb_spi_frame_parser;
+
+    logic       clk = 0;
+    logic       reset;
+
+    logic [7:0] byte_data;
+    logic       byte_valid;
+    logic       byte_first;
+    logic       byte_ready;
+
+    game_cmd_t  cmd;
+    logic       cmd_push;
+
+    logic [2:0]  piece_rng;
+    logic        soft_drop;
+    logic [31:0] seed;
+    logic        seed_valid;
+    logic [7:0]  config_addr, config_data;
+    logic        config_we;
+    logic [7:0]  frame_count, crc_error_count, missed_count, malformed_count;
+
+    spi_frame_parser dut (.*);
+
+    always #10 clk = ~clk;
+
+    // Commands pushed toward command_fifo, oldest first
+    game_cmd_t pushed [$];
+
+    always @(posedge clk) begin
+        if (!reset && cmd_push) pushed.push_back(cmd);
+    end
+
+    logic [7:0] seq = 0;
+
+    // ------------------------------------------------------------
+    // Send one frame; corrupt_crc flips the CRC, skip drops seq numbers
+    // ------------------------------------------------------------
+    task automatic send_frame(input logic [7:0] payload [$],
+                              input bit corrupt_crc = 0,
+                              input logic [3:0] version = VERSION);
+        logic [7:0] bytes [$];
+        logic [7:0] crc;
+
+        bytes = {{version, 4'h0}, seq, 8'(payload.size())};
+        foreach (payload[i]) bytes.push_back(payload[i]);
+
+        crc = 8'h00;
+        foreach (bytes[i]) crc = crc8(crc, bytes[i]);
+        bytes.push_back(corrupt_crc ? ~crc : crc);
+        seq++;
+
+        foreach (bytes[i]) begin
+            @(negedge clk);
+            byte_data  = bytes[i];
+            byte_valid = 1'b1;
+            byte_first = (i == 0);
+            @(negedge clk);
+            byte_valid = 1'b0;
+            repeat (20) @(negedge clk);   // roughly one SPI byte time apart
+        end
+        repeat (30) @(negedge clk);
+    endtask
+
+    // Check the oldest pushed command
+    task automatic expect_cmd(input logic hard_drop, input tetris_pkg::command_t move, input logic hold = 1'b0);
+        game_cmd_t got;
+        if (pushed.size() == 0) begin
+            $error("command missing: expected hold=%0b hard_drop=%0b move=%0d", hold, hard_drop, move);
+            return;
+        end
+        got = pushed.pop_front();
+        if (got.hold !== hold || got.hard_drop !== hard_drop || (!hard_drop && !hold && got.move !== move))
+            $error("command mismatch: got hold=%0b hard_drop=%0b move=%0d", got.hold, got.hard_drop, got.move);
+    endtask
+
+    initial begin
+        $display("=== tb_spi_frame_parser starting ===");
+
+        reset      = 1'b1;
+        byte_valid = 1'b0;
+        byte_first = 1'b0;
+        byte_data  = '0;
+        repeat (4) @(negedge clk);
+        reset = 1'b0;
+
+        // Test 1: piece value + two moves + hard drop + hold in one frame
+        send_frame({OP_PIECE_RNG, 8'd5, OP_MOVE, 8'd2, OP_MOVE, 8'd1, OP_HARD_DROP, OP_HOLD});
+        if (piece_rng !== 3'd5)   $error("Test 1 FAILED: piece_rng = %0d", piece_rng);
+        if (frame_count !== 8'd1) $error("Test 1 FAILED: frame_count = %0d", frame_count);
+        expect_cmd(1'b0, tetris_pkg::CMD_LEFT);
+        expect_cmd(1'b0, tetris_pkg::CMD_ROTATE);
+        expect_cmd(1'b1, tetris_pkg::CMD_SOFT_DROP);
+        expect_cmd(1'b0, tetris_pkg::CMD_SOFT_DROP, 1'b1);
+        if (pushed.size() != 0) $error("Test 1 FAILED: extra commands pushed");
+
+        // Test 2: bad CRC is counted and not executed
+        send_frame({OP_MOVE, 8'd3}, 1);
+        if (crc_error_count !== 8'd1) $error("Test 2 FAILED: crc_error_count = %0d", crc_error_count);
+        repeat (10) @(negedge clk);
+        if (pushed.size() != 0) $error("Test 2 FAILED: corrupted move was pushed");
+
+        // Test 3: the corrupted frame shows up as one missed sequence number
+        send_frame({OP_SEED, 8'h78, 8'h56, 8'h34, 8'h12});
+        if (missed_count !== 8'd1)      $error("Test 3 FAILED: missed_count = %0d", missed_count);
+        if (seed !== 32'h1234_5678)     $error("Test 3 FAILED: seed = %h", seed);
+
+        // Test 4: unknown version is rejected as malformed
+        send_frame({OP_MOVE, 8'd3}, 0, 4'd2);
+        if (malformed_count !== 8'd1) $error("Test 4 FAILED: malformed_count = %0d", malformed_count);
+
+        // Test 5: opcode whose arguments run past the payload is malformed
+        send_frame({OP_CONFIG, 8'd1});
+        if (malformed_count !== 8'd2) $error("Test 5 FAILED: malformed_count = %0d", malformed_count);
+        if (config_we)                $error("Test 5 FAILED: config written");
+
+        // Test 6: soft drop press and release
+        send_frame({OP_SOFT_DROP, 8'd1});
+        if (soft_drop !== 1'b1) $error("Test 6 FAILED: soft_drop not set");
+        send_frame({OP_SOFT_DROP, 8'd0});
+        if (soft_drop !== 1'b0) $error("Test 6 FAILED: soft_drop not cleared");
+
+        $display("=== tb_spi_frame_parser done ===");
+        $finish;
+    end
+
+endmodule
@@ -10,7 +10,8 @@ module top_tetris #(
     parameter vga_pkg::vga_params_t params                = vga_pkg::VGA_640x480_60,
     parameter int                   TELEMETRY_NUM_SIGNALS = 2,
     parameter int                   TELEMETRY_VALUE_WIDTH = 8,
-    parameter int                   TELEMETRY_BASE        = 2
+    parameter int                   TELEMETRY_BASE        = 2,
+    parameter int                   NEXT_PIECES           = 5     // preview queue depth
 )(
     input  logic reset_n,
 
@@ -50,24 +51,67 @@ module top_tetris #(
     logic [7:0] debug_singals_4[2];
     logic [7:0] debug_singals_5[2];
 
+    // Side mini-panels: hold slot, then the next-piece queue
+    logic [5:0] preview_window [6][`COLORS][5:0];
+
     // -----------------
     // SPI / GAME CONTROL
     // -----------------
-    logic [7:0] spi_data;
-    logic       clk_divided;
-    logic [2:0] new_piece_value, offset;
-
-    logic easy_clk;
+    logic [7:0] spi_byte;
+    logic       spi_byte_valid;
+    logic       spi_byte_first;
+    logic       spi_byte_ready;
 
     logic [TELEMETRY_VALUE_WIDTH-1:0] main_telemetry_values[TELEMETRY_NUM_SIGNALS];
 
-    logic game_clk;
-
-    // SPI control flags
-    logic invalidate_spi_data;
-    logic spi_data_new;
-    logic spi_data_valid;
-    logic spi_data_new_stalled;
+    // Game logic runs on HSOSC_clk; gravity steps on a one-cycle enable
+    // paced in VGA frames by gravity_engine
+    logic game_tick;
+    logic frame_tick;
+    logic gravity_20g;
+    logic [$clog2(spi_frame_pkg::GRAVITY_LEVELS)-1:0] GAME_level;
+
+    // SPI frame parser outputs
+    spi_frame_pkg::game_cmd_t spi_cmd;
+    logic       spi_cmd_push;
+    logic [2:0] spi_piece_rng;          // OP_PIECE_RNG, unused since the bag randomizer
+    logic       spi_soft_drop;
+    logic [31:0] spi_seed;
+    logic       spi_seed_valid;
+    logic [7:0] spi_config_addr;
+    logic [7:0] spi_config_data;
+    logic       spi_config_we;
+    logic [7:0] spi_frame_count;
+    logic [7:0] spi_crc_error_count;
+    logic [7:0] spi_missed_count;
+    logic [7:0] spi_malformed_count;
+    logic [7:0] spi_cmd_drop_count;
+
+    // Status frame shifted back to the MCU
+    logic [spi_frame_pkg::STATUS_BYTES*8-1:0] spi_status;
+    game_state_pkg::bitboard_t   GAME_fixed_state;
+    logic [4:0]                  GAME_column_top [10];  // skyline registers
+    tetris_pkg::active_piece_t   GAME_active_piece;
+    logic [15:0]                 GAME_lines_cleared;
+    logic [2:0]                  GAME_clear_count;      // rows removed by the last lock
+    logic                        GAME_clear_valid;
+    logic [7:0]                  GAME_game_over_count;
+    logic                        GAME_game_over;
+    tetris_pkg::piece_type_t     GAME_hold_piece;
+    logic                        GAME_hold_valid;
+
+    // Next-piece queue
+    tetris_pkg::piece_type_t     next_pieces [NEXT_PIECES];
+    logic [NEXT_PIECES-1:0]      next_valid;
+    tetris_pkg::piece_type_t     fill_piece;
+    logic                        fill_taken;
+    logic                        new_piece_taken;
+
+    // Command FIFO head
+    spi_frame_pkg::game_cmd_t game_cmd;
+    logic       game_cmd_valid;
+    logic       game_cmd_pop;
+    logic       game_move_taken;
 
     // -----------------
     // VGA SIGNALS
@@ -102,7 +146,7 @@ module top_tetris #(
     // TELEMETRY
     // -----------------
     assign main_telemetry_values[0] = clk_count;
-    assign main_telemetry_values[1] = spi_data;
+    assign main_telemetry_values[1] = spi_crc_error_count;
 
     // -----------------
     // MODULE INSTANTIATIONS
@@ -156,12 +200,13 @@ module top_tetris #(
         .v_sync              (v_sync),
         .telemetry_values    (main_telemetry_values),
 
-        .debug_window_0 (debug_window_0),
-        .debug_window_1 (debug_window_1),
-        .debug_window_2 (debug_window_2),
-        .debug_window_3 (debug_window_3),
-        .debug_window_4 (debug_window_4),
-        .debug_window_5 (debug_window_5),
+        // Hold slot and next-piece queue in place of the debug windows
+        .debug_window_0 (preview_window[0]),
+        .debug_window_1 (preview_window[1]),
+        .debug_window_2 (preview_window[2]),
+        .debug_window_3 (preview_window[3]),
+        .debug_window_4 (preview_window[4]),
+        .debug_window_5 (preview_window[5]),
 
         // 6 sets of debug signals (2×8-bit each)
         .debug_singals_0 (debug_singals_0),
@@ -172,30 +217,48 @@ module top_tetris #(
         .debug_singals_5 (debug_singals_5)
     );
 
+    piece_preview Hold_Preview(.piece_type(GAME_hold_piece), .valid(GAME_hold_valid), .window(preview_window[0]));
+
+    // Queue entries past the panels are not drawn; missing ones draw blank
+    genvar g;
+    generate
+        for (g = 0; g < 5; g++) begin : gen_next_preview
+            if (g < NEXT_PIECES) begin : gen_shown
+                piece_preview Next_Preview(.piece_type(next_pieces[g]), .valid(next_valid[g]), .window(preview_window[g+1]));
+            end else begin : gen_blank
+                assign preview_window[g+1] = '{default: '{default: '0}};
+            end
+        end
+    endgenerate
+
     tetris_pkg::active_piece_t new_piece;
 
-    synchronizer #(
-        .bits(3)
-    ) Offset_determiner (
-        .clk               (game_clk),
-        .raw_input         (debug_singals_5[1][2:0] + debug_singals_5[1][5:4]),
-        .synchronized_value(offset)
+    // 7-bag sequence from the seed the MCU sends once at boot; no per-piece
+    // SPI traffic. A new seed restarts the bag and the queue.
+    bag_randomizer Bag_Randomizer (
+        .clk        (HSOSC_clk),
+        .reset      (~reset_n),
+        .seed       (spi_seed),
+        .seed_valid (spi_seed_valid),
+        .piece      (fill_piece),
+        .take       (fill_taken)
+    );
+
+    // Pieces are chosen as the queue refills; the game spawns from its head
+    piece_queue #(
+        .DEPTH (NEXT_PIECES)
+    ) Piece_Queue (
+        .clk         (HSOSC_clk),
+        .reset       (~reset_n),
+        .fill_piece  (fill_piece),
+        .fill_taken  (fill_taken),
+        .pop         (new_piece_taken),
+        .flush       (spi_seed_valid),
+        .next_pieces (next_pieces),
+        .next_valid  (next_valid)
     );
 
-    assign new_piece_value = spi_data[4:2] + offset;
-
-    always_comb begin
-        unique case (new_piece_value)
-            3'd0: new_piece = tetris_pkg::HERO;
-            3'd1: new_piece = tetris_pkg::SMASH_BOY;
-            3'd2: new_piece = tetris_pkg::TEEWEE;
-            3'd3: new_piece = tetris_pkg::ORANGE_RICKY;
-            3'd4: new_piece = tetris_pkg::BLUE_RICKY;
-            3'd5: new_piece = tetris_pkg::RHODE_ISLAND_Z;
-            3'd6: new_piece = tetris_pkg::CLEVELAND_Z;
-            default: new_piece = tetris_pkg::HERO;  // or '0 if you prefer
-        endcase
-    end
+    assign new_piece = tetris_pkg::make_piece(next_pieces[0], tetris_pkg::ROT_0);
 
     game_executioner #(
         .TELEMETRY_NUM_SIGNALS(2),
@@ -203,13 +266,32 @@ module top_tetris #(
         .TELEMETRY_BASE       (TELEMETRY_BASE)
     ) Game_Executioner (
         .reset      (~reset_n),
-        .move_clk   (spi_data_new_stalled),
-        .clk        (easy_clk),
-        .game_clk   (game_clk),
-        .move       (tetris_pkg::command_t'(spi_data[1:0])),
-        .move_valid (spi_data[5]),
+        .clk        (HSOSC_clk),
+        .game_tick  (game_tick),
+        .gravity_20g(gravity_20g),
+        .frame_tick (frame_tick),
+        .config_addr(spi_config_addr),
+        .config_data(spi_config_data),
+        .config_we  (spi_config_we),
+        .move       (game_cmd.move),
+        .move_valid (game_cmd_valid),
+        .hard_drop  (game_cmd.hard_drop),
+        .hold       (game_cmd.hold),
+        .move_taken (game_move_taken),
         .new_piece  (new_piece),
+        .new_piece_valid (next_valid[0]),
+        .new_piece_taken (new_piece_taken),
         .GAME_state (GAME_next_frame),
+        .GAME_fixed_state (GAME_fixed_state),
+        .active_piece     (GAME_active_piece),
+        .lines_cleared    (GAME_lines_cleared),
+        .clear_count      (GAME_clear_count),
+        .clear_valid      (GAME_clear_valid),
+        .game_over_count  (GAME_game_over_count),
+        .game_over        (GAME_game_over),
+        .column_top       (GAME_column_top),
+        .hold_piece       (GAME_hold_piece),
+        .hold_valid       (GAME_hold_valid),
 
         .debug_window_0 (debug_window_0),
         .debug_window_1 (debug_window_1),
@@ -227,30 +309,71 @@ module top_tetris #(
         .debug_singals_5 (debug_singals_5)
     );
 
-    spi SPI (
+    spi #(
+        .TX_BYTES   (spi_frame_pkg::STATUS_BYTES)
+    ) SPI (
         .reset      (~reset_n),
         .clk        (HSOSC_clk),
         .sck        (sck),
         .sdi        (sdi),
         .sdo        (sdo),
         .ce         (ce),
-        .clear      (invalidate_spi_data),
-        .data       (spi_data),
-        .data_valid (spi_data_valid)
+        .data       (spi_byte),
+        .data_valid (spi_byte_valid),
+        .data_first (spi_byte_first),
+        .data_ready (spi_byte_ready),
+        .tx_data    (spi_status)
     );
 
-    assign spi_data_new = spi_data_valid; // & ~(^spi_data);
+    // Frames are CRC-checked here, so only intact commands reach the game
+    spi_frame_parser SPI_Frame_Parser (
+        .clk             (HSOSC_clk),
+        .reset           (~reset_n),
+        .byte_data       (spi_byte),
+        .byte_valid      (spi_byte_valid),
+        .byte_first      (spi_byte_first),
+        .byte_ready      (spi_byte_ready),
+        .cmd             (spi_cmd),
+        .cmd_push        (spi_cmd_push),
+        .piece_rng       (spi_piece_rng),
+        .soft_drop       (spi_soft_drop),
+        .seed            (spi_seed),
+        .seed_valid      (spi_seed_valid),
+        .config_addr     (spi_config_addr),
+        .config_data     (spi_config_data),
+        .config_we       (spi_config_we),
+        .frame_count     (spi_frame_count),
+        .crc_error_count (spi_crc_error_count),
+        .missed_count    (spi_missed_count),
+        .malformed_count (spi_malformed_count)
+    );
 
-    synchronizer SPI_Syncstalldata (
-        .clk               (easy_clk),
-        .raw_input         (spi_data_new),
-        .synchronized_value(spi_data_new_stalled)
+    // Bursts of moves queue here and reach the game in order, one per clock
+    command_fifo #(
+        .DEPTH (8)
+    ) Command_FIFO (
+        .clk        (HSOSC_clk),
+        .reset      (~reset_n),
+        .push       (spi_cmd_push),
+        .push_cmd   (spi_cmd),
+        .drop_count (spi_cmd_drop_count),
+        .cmd        (game_cmd),
+        .cmd_valid  (game_cmd_valid),
+        .cmd_pop    (game_cmd_pop)
     );
 
-    synchronizer SPI_Invalidator (
-        .clk               (easy_clk),
-        .raw_input         (spi_data_new_stalled),
-        .synchronized_value(invalidate_spi_data)
+    assign game_cmd_pop = game_move_taken;
+
+    spi_status_builder SPI_Status_Builder (
+        .clk             (HSOSC_clk),
+        .column_top      (GAME_column_top),
+        .active_piece    (GAME_active_piece),
+        .lines_cleared   (GAME_lines_cleared),
+        .game_over_count (GAME_game_over_count),
+        .cmd_drop_count  (spi_cmd_drop_count),
+        .crc_error_count (spi_crc_error_count),
+        .missed_count    (spi_missed_count),
+        .status          (spi_status)
     );
 
     // synchronize external clock
@@ -274,25 +397,33 @@ module top_tetris #(
     // Once new data has come in and chip enable goes low then assert new frame ready
     assign GAME_new_frame_ready = 1'b1;
 
-    clock_divider #(
-        .div_count(4096)
-    ) Clock_Divider (
-        .clk        (LSOSC_clk),
-        .reset      (~reset_n),
-        .clk_divided(clk_divided)
+    // Frames per row by level; the table is written over SPI with OP_CONFIG
+    gravity_engine Gravity_Engine (
+        .clk         (HSOSC_clk),
+        .reset       (~reset_n),
+        .v_sync      (v_sync),
+        .soft_drop   (spi_soft_drop),
+        .clear_count (GAME_clear_count),
+        .clear_valid (GAME_clear_valid),
+        .game_over   (GAME_game_over),
+        .config_addr (spi_config_addr),
+        .config_data (spi_config_data),
+        .config_we   (spi_config_we),
+        .frame_tick  (frame_tick),
+        .game_tick   (game_tick),
+        .gravity_20g (gravity_20g),
+        .level       (GAME_level)
     );
 
-    assign easy_clk = LSOSC_clk;
-
-    always_ff @(posedge game_clk) begin
-        if (~reset_n) clk_count <= 0;
-        else          clk_count <= clk_count + 1;
+    always_ff @(posedge HSOSC_clk) begin
+        if (~reset_n)       clk_count <= 0;
+        else if (game_tick) clk_count <= clk_count + 1;
     end
 
-    // assign game_clk = external_clk_sync_debounce;
-    // assign game_clk = 1'b1;
-    assign game_clk = clk_divided;
-
-    assign debug_led = game_clk;
+    // Blink at the gravity rate
+    always_ff @(posedge HSOSC_clk) begin
+        if (~reset_n)       debug_led <= 1'b0;
+        else if (game_tick) debug_led <= ~debug_led;
+    end
 
 endmodule
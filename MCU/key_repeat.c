@@ -0,0 +1,111 @@
+/*
+ * key_repeat.c
+ * DAS/ARR auto-repeat engine driven by the TIM6 update interrupt.
+ */
+
+#include <stdint.h>
+
+#include "stm32l4xx.h"
+#include "key_repeat.h"
+#include "latency.h"
+#include "ps2_keyboard.h"
+#include "trace.h"
+
+/* ---------------- Per-key configuration and state ---------------- */
+
+// Default timings, in ms. Rotation, hard drop and hold never repeat.
+// Commands are send_spi_moves() key_values (4 = SPI_KEY_HARD_DROP,
+// 5 = SPI_KEY_HOLD). Down is not here: soft drop is a held state sent
+// by spi_send_soft_drop(), and the FPGA's gravity does the repeating.
+static key_repeat_config_t g_repeat_cfg[KEY_REPEAT_NUM_KEYS] = {
+    { '<', 2, 167, 33 },  // Left
+    { '>', 3, 167, 33 },  // Right
+    { '^', 1,   0,  0 },  // Up (rotate)
+    { ' ', 4,   0,  0 },  // Space (hard drop)
+    { 'C', 5,   0,  0 },  // C (hold)
+};
+
+// Runtime state, touched only by the TIM6 ISR
+static uint8_t  g_repeat_held[KEY_REPEAT_NUM_KEYS];
+static uint16_t g_repeat_countdown[KEY_REPEAT_NUM_KEYS];
+
+// Fire counters: the ISR only increments fired, the main loop only
+// advances taken, so pending = fired - taken needs no locking.
+static volatile uint8_t g_repeat_fired[KEY_REPEAT_NUM_KEYS];
+static volatile uint8_t g_repeat_taken[KEY_REPEAT_NUM_KEYS];
+
+/* ---------------- Public API ---------------- */
+
+void key_repeat_init(void) {
+    // 1 MHz counter clock, update event every KEY_REPEAT_TICK_MS
+    TIM6->PSC  = (uint32_t)(SystemCoreClock / 1000000U) - 1;
+    TIM6->ARR  = (KEY_REPEAT_TICK_MS * 1000U) - 1;
+    TIM6->EGR |= TIM_EGR_UG;     // load prescaler
+    TIM6->SR  &= ~TIM_SR_UIF;    // UG sets UIF, clear it
+    TIM6->DIER |= TIM_DIER_UIE;  // update interrupt
+    TIM6->CR1 |= TIM_CR1_CEN;
+
+    NVIC_EnableIRQ(TIM6_DAC_IRQn);
+}
+
+uint8_t key_repeat_set_timing(char key, uint16_t das_ms, uint16_t arr_ms) {
+    for (uint8_t i = 0; i < KEY_REPEAT_NUM_KEYS; i++) {
+        if (g_repeat_cfg[i].key == key) {
+            g_repeat_cfg[i].das_ms = das_ms;
+            g_repeat_cfg[i].arr_ms = arr_ms;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t key_repeat_take_fires(uint8_t slot, uint8_t *command) {
+    uint8_t fired   = g_repeat_fired[slot];
+    uint8_t pending = (uint8_t)(fired - g_repeat_taken[slot]);
+
+    *command = g_repeat_cfg[slot].command;
+    g_repeat_taken[slot] = fired;
+    return pending;
+}
+
+/* ---------------- TIM6 ISR (DAS/ARR state machine) ---------------- */
+
+void TIM6_DAC_IRQHandler(void) {
+    if (!(TIM6->SR & TIM_SR_UIF)) {
+        return;
+    }
+    TIM6->SR &= ~TIM_SR_UIF;
+
+    for (uint8_t i = 0; i < KEY_REPEAT_NUM_KEYS; i++) {
+        const key_repeat_config_t *cfg = &g_repeat_cfg[i];
+
+        // Presses come from the keyboard's 0 -> 1 latch, so a tap shorter
+        // than one tick still fires exactly once
+        uint8_t pressed = keyboard_take_key_press(cfg->key);
+        uint8_t down    = keyboard_get_key_state(cfg->key);
+
+        if (pressed) {
+            // Initial press: fire now, start the DAS delay. Arm the latency
+            // measurement before the main loop can see the fire.
+            uint32_t rx_us, scan_us;
+            keyboard_get_press_stamps(cfg->key, &rx_us, &scan_us);
+            latency_arm(cfg->command, rx_us, scan_us);
+
+            g_repeat_fired[i]++;
+            trace_log(TRACE_REPEAT_FIRE, i | (cfg->command << 8));
+            g_repeat_held[i]      = 1;
+            g_repeat_countdown[i] = cfg->das_ms;
+        } else if (down && g_repeat_held[i] && cfg->arr_ms != 0) {
+            // Held: count down DAS, then repeat every ARR
+            if (g_repeat_countdown[i] > KEY_REPEAT_TICK_MS) {
+                g_repeat_countdown[i] -= KEY_REPEAT_TICK_MS;
+            } else {
+                g_repeat_fired[i]++;
+                g_repeat_countdown[i] = cfg->arr_ms;
+                trace_log(TRACE_REPEAT_FIRE, i | (cfg->command << 8));
+            }
+        } else if (!down) {
+            g_repeat_held[i] = 0;
+        }
+    }
+}
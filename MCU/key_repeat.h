@@ -0,0 +1,52 @@
+#ifndef KEY_REPEAT_H
+#define KEY_REPEAT_H
+
+#include <stdint.h>
+
+/*
+ * key_repeat.h
+ * Delayed-auto-shift (DAS) / auto-repeat-rate (ARR) engine for the game keys.
+ *
+ * TIM6 ticks every KEY_REPEAT_TICK_MS and samples the keyboard state. A key
+ * fires once on press, again after its DAS delay, and then every ARR period
+ * while it stays held. The ISR only counts fires; the main loop turns them
+ * into SPI commands with key_repeat_take_fires(), so the SPI bus is never
+ * touched from interrupt context.
+ */
+
+#define KEY_REPEAT_TICK_MS   1
+#define KEY_REPEAT_NUM_KEYS  5
+
+// One repeatable game key
+typedef struct {
+    char     key;      // keyboard_get_key_state() character, e.g. '<'
+    uint8_t  command;  // key_value passed to send_spi_moves()
+    uint16_t das_ms;   // hold time before auto-repeat starts
+    uint16_t arr_ms;   // interval between repeats (0 = fire on press only)
+} key_repeat_config_t;
+
+/**
+ * Configure TIM6 for the repeat tick and enable its interrupt.
+ * The TIM6 peripheral clock must already be enabled.
+ */
+void key_repeat_init(void);
+
+/**
+ * Change DAS/ARR for one key at runtime. Returns 0 if the key is not one
+ * of the repeatable keys.
+ */
+uint8_t key_repeat_set_timing(char key, uint16_t das_ms, uint16_t arr_ms);
+
+/**
+ * Number of fires for slot (0..KEY_REPEAT_NUM_KEYS-1) not yet taken by the
+ * main loop; marks them as taken. *command receives the slot's command.
+ */
+uint8_t key_repeat_take_fires(uint8_t slot, uint8_t *command);
+
+/**
+ * TIM6 update interrupt: runs the DAS/ARR state machine for every key.
+ * (Name must match the vector table.)
+ */
+void TIM6_DAC_IRQHandler(void);
+
+#endif // KEY_REPEAT_H
@@ -0,0 +1,116 @@
+/*
+ * latency.c
+ * Press-to-SPI latency histograms (see latency.h).
+ */
+
+#include <stdint.h>
+
+#include "stm32l4xx.h"
+#include "latency.h"
+#include "trace.h"
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[LATENCY_NUM_BUCKETS];
+} latency_hist_t;
+
+// Written only from main-loop context (spi_service / latency_report)
+static latency_hist_t g_latency_hist[LATENCY_NUM_STAGES];
+
+// One pending press per command. The ISR writes the stamps and then sets
+// armed; the main loop clears armed once it has used them.
+static volatile uint32_t g_latency_rx_us[LATENCY_NUM_COMMANDS];
+static volatile uint32_t g_latency_scan_us[LATENCY_NUM_COMMANDS];
+static volatile uint8_t  g_latency_armed[LATENCY_NUM_COMMANDS];
+
+// Values below LATENCY_SUB_BUCKETS get a bucket each; above that, each
+// power of two [2^e, 2^(e+1)) is split into LATENCY_SUB_BUCKETS slices.
+static uint32_t latency_bucket(uint32_t us) {
+    if (us < LATENCY_SUB_BUCKETS) {
+        return us;
+    }
+    uint32_t e = 31 - __CLZ(us);  // e >= 3
+    uint32_t b = (e - 2) * LATENCY_SUB_BUCKETS + ((us >> (e - 3)) & (LATENCY_SUB_BUCKETS - 1));
+    return (b < LATENCY_NUM_BUCKETS) ? b : LATENCY_NUM_BUCKETS - 1;
+}
+
+// Smallest value that lands in bucket b
+static uint32_t latency_bucket_floor(uint32_t b) {
+    if (b < LATENCY_SUB_BUCKETS) {
+        return b;
+    }
+    uint32_t e = b / LATENCY_SUB_BUCKETS + 2;
+    return (LATENCY_SUB_BUCKETS + b % LATENCY_SUB_BUCKETS) << (e - 3);
+}
+
+static void latency_record(latency_stage_t stage, uint32_t us) {
+    latency_hist_t *h = &g_latency_hist[stage];
+
+    if (h->count == 0 || us < h->min_us) h->min_us = us;
+    if (us > h->max_us)                  h->max_us = us;
+    h->count++;
+    h->sum_us += us;
+
+    h->buckets[latency_bucket(us)]++;
+}
+
+void latency_arm(uint8_t command, uint32_t rx_us, uint32_t scan_us) {
+    command &= LATENCY_NUM_COMMANDS - 1;
+    g_latency_rx_us[command]   = rx_us;
+    g_latency_scan_us[command] = scan_us;
+    g_latency_armed[command]   = 1;
+}
+
+void latency_on_spi_send(uint8_t command, uint32_t spi_us) {
+    command &= LATENCY_NUM_COMMANDS - 1;
+    if (!g_latency_armed[command]) {
+        return;  // auto-repeat, or a command not caused by a key press
+    }
+
+    uint32_t rx_us   = g_latency_rx_us[command];
+    uint32_t scan_us = g_latency_scan_us[command];
+    g_latency_armed[command] = 0;
+
+    latency_record(LATENCY_RX_TO_SCAN,  scan_us - rx_us);
+    latency_record(LATENCY_SCAN_TO_SPI, spi_us - scan_us);
+    latency_record(LATENCY_RX_TO_SPI,   spi_us - rx_us);
+}
+
+void latency_get_stats(latency_stage_t stage, latency_stats_t *stats) {
+    const latency_hist_t *h = &g_latency_hist[stage];
+
+    stats->count   = h->count;
+    stats->min_us  = h->min_us;
+    stats->max_us  = h->max_us;
+    stats->mean_us = h->count ? (uint32_t)(h->sum_us / h->count) : 0;
+    stats->p99_us  = 0;
+
+    // Walk up the histogram until 99% of the samples are covered
+    uint32_t target = h->count - h->count / 100;
+    uint32_t seen   = 0;
+    for (uint32_t b = 0; b < LATENCY_NUM_BUCKETS && h->count; b++) {
+        seen += h->buckets[b];
+        if (seen >= target) {
+            stats->p99_us = latency_bucket_floor(b);
+            break;
+        }
+    }
+}
+
+void latency_report(void) {
+    for (uint32_t stage = 0; stage < LATENCY_NUM_STAGES; stage++) {
+        latency_stats_t s;
+        latency_get_stats((latency_stage_t) stage, &s);
+
+        const uint32_t values[LATENCY_NUM_STATS] = {
+            s.count, s.min_us, s.mean_us, s.p99_us, s.max_us,
+        };
+        for (uint32_t stat = 0; stat < LATENCY_NUM_STATS; stat++) {
+            uint32_t v = (values[stat] > 0xFFFFFF) ? 0xFFFFFF : values[stat];
+            trace_log(TRACE_LATENCY, (stage << 28) | (stat << 24) | v);
+        }
+    }
+}
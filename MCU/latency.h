@@ -0,0 +1,76 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+
+/*
+ * latency.h
+ * Input-latency histograms: PS/2 byte in -> SPI word out.
+ *
+ * Every key press is stamped with timebase_now_us() three times:
+ *   rx   : first byte of its PS/2 sequence reaches the receive interrupt
+ *   scan : scanKeyboard() takes the event off the PS/2 ring
+ *   spi  : the DMA finishes sending the frame with the command
+ * The TIM6 repeat engine arms the command's slot with the rx/scan stamps
+ * when it fires the initial press, and spi_service() closes it. DAS/ARR
+ * repeats are deliberately not measured: they have no input byte.
+ *
+ * Each stage keeps a log-linear histogram (8 buckets per power of two, so
+ * percentiles are within 12.5%) plus exact count/min/max/mean.
+ * latency_report() ships the summary as TRACE_LATENCY records.
+ */
+
+#define LATENCY_NUM_COMMANDS  8    // key_value: 0-3 moves, 4 hard drop, 5 hold
+#define LATENCY_SUB_BUCKETS   8    // buckets per power of two
+#define LATENCY_NUM_BUCKETS   (30 * LATENCY_SUB_BUCKETS)
+
+typedef enum {
+    LATENCY_RX_TO_SCAN = 0,  // waiting in the PS/2 event ring
+    LATENCY_SCAN_TO_SPI,     // repeat tick + main loop + SPI transfer
+    LATENCY_RX_TO_SPI,       // end to end
+    LATENCY_NUM_STAGES
+} latency_stage_t;
+
+// Summary statistic ids, as used in TRACE_LATENCY payloads
+typedef enum {
+    LATENCY_STAT_COUNT = 0,
+    LATENCY_STAT_MIN,
+    LATENCY_STAT_MEAN,
+    LATENCY_STAT_P99,
+    LATENCY_STAT_MAX,
+    LATENCY_NUM_STATS
+} latency_stat_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t mean_us;
+    uint32_t p99_us;   // lower edge of the bucket holding the 99th percentile
+    uint32_t max_us;
+} latency_stats_t;
+
+/**
+ * Remember the rx/scan stamps of a press that has just been turned into
+ * command. Called from the TIM6 ISR.
+ */
+void latency_arm(uint8_t command, uint32_t rx_us, uint32_t scan_us);
+
+/**
+ * Close the measurement for command if one is armed. Called from
+ * spi_service() in main-loop context with the time the frame left.
+ */
+void latency_on_spi_send(uint8_t command, uint32_t spi_us);
+
+/**
+ * Summary of one stage so far.
+ */
+void latency_get_stats(latency_stage_t stage, latency_stats_t *stats);
+
+/**
+ * Log every stage's summary to the trace log, one TRACE_LATENCY record
+ * per statistic (payload: stage << 28 | stat << 24 | value_us, the value
+ * saturating at 24 bits). Main-loop context only.
+ */
+void latency_report(void);
+
+#endif // LATENCY_H
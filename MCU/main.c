@@ -15,18 +15,20 @@ Date: 11/6/25
 #include "random.h"
 #include "stm32l4xx.h"
 
+#include "key_repeat.h"
+#include "latency.h"
 #include "ps2_keyboard.h"
 #include "spi_protocol.h"
+#include "spi_tx_queue.h"
+#include "timebase.h"
+#include "trace.h"
 
 //// ---- Module-level variables ---- ////
 
 USART_TypeDef *USART;  // handle for USART1 from initUSART()
 
-// Edge-detect state for arrow keys
-static uint8_t last_up    = 0;
-static uint8_t last_down  = 0;
-static uint8_t last_left  = 0;
-static uint8_t last_right = 0;
+#define LATENCY_REPORT_US  5000000U  // latency summary period
+#define STATUS_POLL_US       50000U  // refresh the FPGA status mirror when idle
 
 //// -----------------------------------------------------------------
 ////  Helper functions: each does "one thing" and keeps main readable
@@ -48,86 +50,127 @@ static void system_init_gpio(void) {
     //digitalWrite(RESET_N, 0);
 }
 
-// Enable and configure TIM15/TIM16
+// Enable and configure TIM6 (key auto-repeat tick) and TIM2 (microsecond
+// timebase for latency stamps)
 static void system_init_timers(void) {
     // Enable timer peripheral clocks
-    RCC->APB2ENR |= (RCC_APB2ENR_TIM15EN);
-    RCC->APB2ENR |= (RCC_APB2ENR_TIM16EN);
+    RCC->APB1ENR1 |= (RCC_APB1ENR1_TIM6EN | RCC_APB1ENR1_TIM2EN);
 
-    initTIM(TIM15);
-    initTIM(TIM16);
+    timebase_init();
 }
 
 // Start any periodic timers used by the application
 static void system_start_timers(void) {
-    begin_timer(TIM15, 1000);   // 1-second initial period (random update)
-    begin_timer(TIM16, 1000);   // used by keyboard_update_state() gating
+    key_repeat_init();          // DAS/ARR tick interrupt (ISR in key_repeat.c)
 }
 
-// Configure SPI signals + random number generator used in SPI payload
+// Configure SPI signals + random number generator for the piece seed
 static void system_init_spi_and_random(void) {
     // Enable SPI1 peripheral clock
     RCC->APB2ENR |= (1 << 12);
 
     configureSPIPins();
-    initSPI(0b111, 0, 0);
+    initSPI(0b011, 0, 0);   // 80 MHz / 16 = 5 MHz; the FPGA shifts on sck directly
+    spi_tx_queue_init();    // SPI1 TX/RX on DMA, CS in the completion ISR
 
     initRandomGenerator();
 }
 
-// Configure USART1 to receive PS/2 bitstream and enable its interrupt
+// Configure USART1 to receive PS/2 bitstream and start reception
 static void system_init_usart_ps2(void) {
     USART = initUSART(USART1_ID, 11500);  // same baud as original code
 
-    // Enable RXNE interrupt on this USART
-    USART->CR1 |= USART_CR1_RXNEIE;
+    // RXNE interrupt or circular DMA, per PS2_USE_DMA (ps2_keyboard.c)
+    keyboard_init_rx();
+}
 
-    // Enable USART1 interrupt line in the NVIC (ISR in ps2_keyboard.c)
-    NVIC_EnableIRQ(USART1_IRQn);
+// Bring up the binary trace log (DWT timestamps + USART2/RTT sink)
+static void system_init_trace(void) {
+    trace_init();
 }
 
-// Poll the PS/2 mailbox and update the internal keyboard state
+// Drain the PS/2 event ring and update the internal keyboard state
 static void update_keyboard_state(void) {
     // All the heavy lifting is inside ps2_keyboard.c
     scanKeyboard();
 }
 
-// Look for new arrow-key presses and send a corresponding SPI word
+// Send every press / auto-repeat the TIM6 DAS/ARR engine has fired since
+// the last pass (key_value: 1 Up, 2 Left, 3 Right, 4 Space = hard drop,
+// 5 C = hold). Keys that fired in the same pass go out together in one SPI
+// frame. Fires are taken from key_repeat as soon as they are seen, so ones
+// that do not fit a full transmit queue stay pending here for the next pass.
 static void handle_arrow_key_edges(void) {
-    // Current snapshot of arrow keys
-    uint8_t up_now    = keyboard_get_key_state('^');
-    uint8_t down_now  = keyboard_get_key_state('v');
-    uint8_t left_now  = keyboard_get_key_state('<');
-    uint8_t right_now = keyboard_get_key_state('>');
-
-    // Edge-detect: send a word only when key transitions 0 -> 1
-    if (up_now && !last_up) {
-        // key_value = 1 for Up
-        send_spi_word(1, 1);
-    } else if (down_now && !last_down) {
-        // key_value = 0 for Down
-        send_spi_word(1, 0);
-    } else if (left_now && !last_left) {
-        // key_value = 2 for Left
-        send_spi_word(1, 2);
-    } else if (right_now && !last_right) {
-        // key_value = 3 for Right
-        send_spi_word(1, 3);
+    static uint8_t pending[KEY_REPEAT_NUM_KEYS];
+    static uint8_t commands[KEY_REPEAT_NUM_KEYS];
+
+    // Collect all new fires first so no key can mask another
+    for (uint8_t slot = 0; slot < KEY_REPEAT_NUM_KEYS; slot++) {
+        pending[slot] += key_repeat_take_fires(slot, &commands[slot]);
+    }
+
+    // Round-robin over the pending keys, SPI_FRAME_MAX_MOVES per frame; a
+    // key only has more than one fire if the loop stalled for over an ARR
+    // period or the queue was full
+    while (1) {
+        uint8_t moves[SPI_FRAME_MAX_MOVES];
+        uint8_t slots[SPI_FRAME_MAX_MOVES];
+        uint8_t count = 0;
+
+        for (uint8_t slot = 0; slot < KEY_REPEAT_NUM_KEYS && count < SPI_FRAME_MAX_MOVES; slot++) {
+            if (pending[slot]) {
+                slots[count]   = slot;
+                moves[count++] = commands[slot];
+            }
+        }
+        if (count == 0 || !send_spi_moves(moves, count)) {
+            return;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            pending[slots[i]]--;
+        }
     }
+}
 
-    // Latch for next iteration
-    last_up    = up_now;
-    last_down  = down_now;
-    last_left  = left_now;
-    last_right = right_now;
+// Soft drop is held, not repeated: send the Down key's state whenever it
+// changes and let the FPGA speed up gravity in between. A full transmit
+// queue leaves the state unsent, so the next pass retries.
+static void handle_soft_drop_key(void) {
+    static uint8_t sent_held = 0;
+    uint8_t held = keyboard_get_key_state('v') ? 1 : 0;
+
+    if (held != sent_held && spi_send_soft_drop(held)) {
+        sent_held = held;
+    }
 }
 
-// Periodically refresh the 3-bit random field used in the SPI payload
-static void handle_periodic_random_update(void) {
-    if (check_timer(TIM15)) {
-        update_random3();          // defined in spi_protocol.c
-        //send_spi_word(0, 0);     // optional idle / heartbeat packet
-        begin_timer(TIM15, 5000);  // 5-second period after first tick
+// Seed the FPGA's 7-bag piece generator once from the hardware RNG; the
+// FPGA draws every piece itself after that
+static void send_piece_seed(void) {
+    spi_send_seed(getRandomNumber());
+}
+
+// Keep the FPGA status mirror fresh: every transfer returns a status frame,
+// so only poll when no frame has gone out for STATUS_POLL_US
+static void handle_status_poll(void) {
+    static uint32_t last_poll_us = 0;
+    uint32_t now = timebase_now_us();
+
+    if ((uint32_t)(now - spi_get_status()->updated_us) >= STATUS_POLL_US &&
+        (uint32_t)(now - last_poll_us) >= STATUS_POLL_US) {
+        last_poll_us = now;
+        spi_poll_status();
+    }
+}
+
+// Every LATENCY_REPORT_US, log the latency histogram summary to the trace
+static void handle_latency_report(void) {
+    static uint32_t last_report_us = 0;
+    uint32_t now = timebase_now_us();
+
+    if ((uint32_t)(now - last_report_us) >= LATENCY_REPORT_US) {
+        last_report_us = now;
+        latency_report();
     }
 }
 
@@ -136,24 +179,33 @@ static void handle_periodic_random_update(void) {
 //  - Initialize hardware
 //  - Run control loop:
 //      * update keyboard from PS/2
-//      * detect arrow presses
-//      * periodically update random bits
+//      * queue arrow presses / auto-repeats (one SPI frame per pass)
+//      * send soft drop press / release
+//      * collect finished SPI transfers and the FPGA status they carry
+//      * periodically report input latency
+//      * drain the trace log
 /////////////////////////////////////////////////////////////////
 
 int main(void) {
     // ---- One-time system bring-up ----
     system_init_clocks_and_flash();
+    system_init_trace();
     system_init_gpio();
     system_init_timers();
     system_init_spi_and_random();
     system_init_usart_ps2();
     system_start_timers();
+    send_piece_seed();
 
     // ---- Main application loop ----
     while (1) {
-        update_keyboard_state();        // pull new PS/2 events from ISR
-        handle_arrow_key_edges();       // send SPI word on arrow press
-        handle_periodic_random_update();// refresh random bits on TIM15
+        update_keyboard_state();        // drain queued PS/2 events from ISR
+        handle_arrow_key_edges();       // queue SPI frames for DAS/ARR fires
+        handle_soft_drop_key();         // soft drop press / release
+        spi_service();                  // collect sent frames + FPGA status
+        handle_status_poll();           // empty frame if the status is stale
+        handle_latency_report();        // latency summary every 5 s
+        trace_drain();                  // ship trace records in idle time
         // delay_millis(TIM16, 10);
     }
 }
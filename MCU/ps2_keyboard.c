@@ -4,212 +4,89 @@
  */
 
 #include <stdint.h>
-#include <stdio.h>
 
 #include "stm32l4xx.h"
 #include "ps2_keyboard.h"
-#include "main.h"  // for check_timer / begin_timer / TIM16 etc.
+#include "ps2_scancodes.h"
+#include "timebase.h"
+#include "trace.h"
+#include "main.h"
 
-/* ---------------- Keyboard state and PS/2 mailbox ---------------- */
+/* ---------------- Keyboard state and PS/2 event ring ---------------- */
 
 #define KB_MAX_KEYS 128
 
-// Latched state: 1 = this ASCII key has been pressed (per current logic)
+// Number of completed PS/2 events the ISR can queue ahead of scanKeyboard().
+// Must be a power of two that divides 256 (indices are free-running uint8_t).
+#define PS2_EVENT_RING_SIZE 16
+#define PS2_EVENT_RING_MASK (PS2_EVENT_RING_SIZE - 1)
+
+// One completed Scan Code Set 2 sequence, e.g. [0xE0, 0xF0, 0x75]
+// reduced to its last byte plus PS2_FLAG_* prefix flags
+typedef struct {
+    uint32_t rx_us;  // timebase_now_us() when its first byte was received
+    uint8_t  code;
+    uint8_t  flags;
+} ps2_event_t;
+
+// Latched state: 1 = this ASCII key is currently held down
 static volatile uint8_t g_keyboard_state[KB_MAX_KEYS] = {0};
 
-// Mailbox for one completed PS/2 event assembled by the ISR
-static volatile uint8_t g_ps2_req[3];
-static volatile uint8_t g_ps2_len         = 0;
-static volatile uint8_t g_ps2_event_ready = 0;
-
-// Debug counter used in keyboard_update_state()
-static int g_press_count = 0;
-
-/* ---------------- Scan-code decoding (Set 2 -> printable char) ---------------- */
-
-// Decode a single make-code sequence in Scan Code Set 2.
-// request[] holds either:
-//   [code]              (len = 1)        e.g. 0x1C for 'A'
-//   [0xE0, code]        (len = 2)        e.g. 0xE0 0x75 for Up Arrow
-// We ignore break codes (anything with F0) before calling this.
-// Returns 0 if we don't know how to print it.
-static char decode_scancode(const uint8_t *request, int len) {
-    uint8_t code = request[len - 1];  // last byte is the make code
-
-    // Handle a few extended keys:
-    if (len == 2 && request[0] == 0xE0) {
-        switch (code) {
-            case 0x75: return '^';  // Up arrow (placeholder)
-            case 0x72: return 'v';  // Down arrow
-            case 0x6B: return '<';  // Left arrow
-            case 0x74: return '>';  // Right arrow
-            default: break;
-        }
-    }
+// Sticky 0 -> 1 edge per key, set here and cleared by keyboard_take_key_press()
+static volatile uint8_t g_keyboard_pressed[KB_MAX_KEYS] = {0};
 
-    // Printable ASCII-ish keys (letters, digits, punctuation, space)
-    switch (code) {
-        // Row: ` 1 2 3 4 5 6 7 8 9 0 - =
-        case 0x0E: return '`';
-        case 0x16: return '1';
-        case 0x1E: return '2';
-        case 0x26: return '3';
-        case 0x25: return '4';
-        case 0x2E: return '5';
-        case 0x36: return '6';
-        case 0x3D: return '7';
-        case 0x3E: return '8';
-        case 0x46: return '9';
-        case 0x45: return '0';
-        case 0x4E: return '-';
-        case 0x55: return '=';
-
-        // Row: Q W E R T Y U I O P [ ]
-        case 0x15: return 'Q';
-        case 0x1D: return 'W';
-        case 0x24: return 'E';
-        case 0x2D: return 'R';
-        case 0x2C: return 'T';
-        case 0x35: return 'Y';
-        case 0x3C: return 'U';
-        case 0x43: return 'I';
-        case 0x44: return 'O';
-        case 0x4D: return 'P';
-        case 0x54: return '[';
-        case 0x5B: return ']';
-
-        // Row: A S D F G H J K L ; ' \
-        case 0x1C: return 'A';
-        case 0x1B: return 'S';
-        case 0x23: return 'D';
-        case 0x2B: return 'F';
-        case 0x34: return 'G';
-        case 0x33: return 'H';
-        case 0x3B: return 'J';
-        case 0x42: return 'K';
-        case 0x4B: return 'L';
-        case 0x4C: return ';';
-        case 0x52: return '\'';
-        case 0x5D: return '\\';
-
-        // Row: Z X C V B N M , . /
-        case 0x1A: return 'Z';
-        case 0x22: return 'X';
-        case 0x21: return 'C';
-        case 0x2A: return 'V';
-        case 0x32: return 'B';
-        case 0x31: return 'N';
-        case 0x3A: return 'M';
-        case 0x41: return ',';
-        case 0x49: return '.';
-        case 0x4A: return '/';
-
-        // Space and control-ish keys mapped to common chars
-        case 0x29: return ' ';   // Space
-        case 0x5A: return '\n';  // Enter
-        case 0x0D: return '\t';  // Tab
-        case 0x66: return '\b';  // Backspace
-        case 0x76: return 27;    // ESC
-
-        default:
-            return 0; // Unknown / not mapped
-    }
-}
+// Timestamps of the press behind each latch, written before the latch is set
+static volatile uint32_t g_keyboard_press_rx_us[KB_MAX_KEYS];
+static volatile uint32_t g_keyboard_press_scan_us[KB_MAX_KEYS];
 
-/* ---------------- Public keyboard API ---------------- */
+// Single-producer (USART1 / DMA ISR) / single-consumer (scanKeyboard) ring.
+// The ISR only writes g_ps2_head, the main loop only writes g_ps2_tail,
+// so neither side ever needs to mask interrupts.
+static ps2_event_t       g_ps2_ring[PS2_EVENT_RING_SIZE];
+static volatile uint8_t  g_ps2_head           = 0;
+static volatile uint8_t  g_ps2_tail           = 0;
+static volatile uint32_t g_ps2_overflow_count = 0;
 
-// Update global keyboard state based on the latest make-code in `request`.
-// Only called when we've established a *make* (key press), never on breaks.
-// request / req_len come from scanKeyboard().
-// Handles normal + extended, make + break.
-// Formats we expect:
-//
-//   Make (normal):        [code]
-//   Make (extended):      [0xE0, code]
-//   Break (normal):       [0xF0, code]
-//   Break (extended):     [0xE0, 0xF0, code]
-//
-// We convert these into a "make-style" temp buffer for decode_scancode()
-// and then set g_keyboard_state[ch] = 1 (press) or 0 (release).
-void keyboard_update_state(const uint8_t *request, int req_len) {
-    if (req_len <= 0) {
-        return;
-    }
+// Receive interrupts taken (RXNE, or DMA half/full + idle line)
+static volatile uint32_t g_ps2_irq_count = 0;
 
-    uint8_t is_break = 0;
-    uint8_t temp[2];
-    int     tlen = 0;
-
-    // --------- Classify the event & build a temp buffer ---------
-    if (req_len == 1) {
-        // Simple make: [code]
-        is_break = 0;
-        temp[0]  = request[0];
-        tlen     = 1;
-    } else if (req_len == 2) {
-        if (request[0] == 0xE0) {
-            // Extended make: [0xE0, code]
-            is_break = 0;
-            temp[0]  = 0xE0;
-            temp[1]  = request[1];
-            tlen     = 2;
-        } else if (request[0] == 0xF0) {
-            // Normal break: [0xF0, code]
-            is_break = 1;
-            temp[0]  = request[1];  // decode like a normal 1-byte make
-            tlen     = 1;
-        } else {
-            // Fallback: treat as make of last byte
-            is_break = 0;
-            temp[0]  = request[req_len - 1];
-            tlen     = 1;
-        }
-    } else if (req_len == 3) {
-        // Extended break: [0xE0, 0xF0, code]
-        if (request[0] == 0xE0 && request[1] == 0xF0) {
-            is_break = 1;
-            temp[0]  = 0xE0;
-            temp[1]  = request[2];
-            tlen     = 2;
-        } else {
-            // Fallback: best effort – treat last as simple code
-            is_break = 0;
-            temp[0]  = request[req_len - 1];
-            tlen     = 1;
-        }
-    } else {
-        // Unexpected length, best-effort decode last byte
-        is_break = 0;
-        temp[0]  = request[req_len - 1];
-        tlen     = 1;
-    }
+/* ---------------- Public keyboard API ---------------- */
 
-    // --------- Map to a printable "key" using decoder ---------
-    char ch = decode_scancode(temp, tlen);
-    if (ch == 0) {
+// Update global keyboard state from one completed event.
+// code / flags come from the prefix state machine in ps2_feed_byte()
+// via scanKeyboard(): code is the last byte of the sequence and flags
+// carries PS2_FLAG_EXTENDED (0xE0 seen) and PS2_FLAG_BREAK (0xF0 seen).
+// Sets g_keyboard_state[ch] = 1 (press) or 0 (release). Typematic repeats
+// of an already-held key are ignored; auto-repeat is key_repeat.c's job.
+// rx_us / scan_us are kept with a press for the latency histograms.
+static void keyboard_apply_event(uint8_t code, uint8_t flags,
+                                 uint32_t rx_us, uint32_t scan_us) {
+    // --------- Map to a printable "key" with one table lookup ---------
+    unsigned char idx = (unsigned char) ps2_set2_lookup(code, flags);
+    if (idx == 0 || idx >= KB_MAX_KEYS) {
         return;  // unmapped key, ignore
     }
 
-    unsigned char idx = (unsigned char) ch;
-    if (idx >= KB_MAX_KEYS) {
-        return;
-    }
-
     // --------- Update global pressed/released state ---------
-    if (is_break) {
+    if (flags & PS2_FLAG_BREAK) {
         g_keyboard_state[idx] = 0;
-    } else {
-        if (check_timer(TIM16)) {
-            g_keyboard_state[idx] = 1;
-            printf("press \n %d", g_press_count);
-            g_press_count++;
-            begin_timer(TIM16, 100);
-        } else {
-            g_keyboard_state[idx] = 0;
-        }
+        trace_log(TRACE_KEY_RELEASE, idx);
+    } else if (!g_keyboard_state[idx]) {
+        // Stamps before the latch, and the edge before the level, so a
+        // reader never sees the key down without its press
+        g_keyboard_press_rx_us[idx]   = rx_us;
+        g_keyboard_press_scan_us[idx] = scan_us;
+        g_keyboard_pressed[idx] = 1;
+        g_keyboard_state[idx]   = 1;
+        trace_log(TRACE_KEY_PRESS, idx);
     }
 }
 
+void keyboard_update_state(uint8_t code, uint8_t flags) {
+    uint32_t now = timebase_now_us();
+    keyboard_apply_event(code, flags, now, now);
+}
+
 // Getter you can call from main loop: non-zero if this key is pressed.
 uint8_t keyboard_get_key_state(char key) {
     unsigned char idx = (unsigned char) key;
@@ -219,109 +96,197 @@ uint8_t keyboard_get_key_state(char key) {
     return 0;
 }
 
-// Pull a new event from the ISR mailbox (if any) and feed it into
-// keyboard_update_state().
+// Returns 1 once per 0 -> 1 transition of key, even if the key has already
+// been released again, then clears the latch.
+uint8_t keyboard_take_key_press(char key) {
+    unsigned char idx = (unsigned char) key;
+    if (idx < KB_MAX_KEYS && g_keyboard_pressed[idx]) {
+        g_keyboard_pressed[idx] = 0;
+        return 1;
+    }
+    return 0;
+}
+
+// Timestamps of the most recent press of key (see keyboard_take_key_press()).
+void keyboard_get_press_stamps(char key, uint32_t *rx_us, uint32_t *scan_us) {
+    unsigned char idx = (unsigned char) key;
+    if (idx < KB_MAX_KEYS) {
+        *rx_us   = g_keyboard_press_rx_us[idx];
+        *scan_us = g_keyboard_press_scan_us[idx];
+    } else {
+        *rx_us = *scan_us = 0;
+    }
+}
+
+// Number of completed events the ISR had to discard because the ring was full.
+uint32_t keyboard_get_overflow_count(void) {
+    return g_ps2_overflow_count;
+}
+
+// Number of receive interrupts taken so far, for comparing PS2_USE_DMA modes.
+uint32_t keyboard_get_irq_count(void) {
+    return g_ps2_irq_count;
+}
+
+// Drain every event the ISR has queued since the last call and feed each one
+// into keyboard_update_state(), oldest first.
 void scanKeyboard(void) {
-    // If no new event from ISR, nothing to do
-    if (!g_ps2_event_ready) {
+    // Snapshot the producer index once; anything the ISR adds while we are
+    // draining is picked up on the next main-loop pass.
+    uint8_t head = g_ps2_head;
+    uint8_t tail = g_ps2_tail;
+
+    // Make sure the slot contents are read after the head index
+    __DMB();
+
+    while (tail != head) {
+        const ps2_event_t *ev = &g_ps2_ring[tail & PS2_EVENT_RING_MASK];
+        keyboard_apply_event(ev->code, ev->flags, ev->rx_us, timebase_now_us());
+        tail++;
+    }
+
+    // Finish reading the slots before handing them back to the ISR
+    __DMB();
+    g_ps2_tail = tail;
+}
+
+/* ---------------- PS/2 byte assembler ---------------- */
+
+// Queue one completed sequence for scanKeyboard(). Called only from the
+// receive interrupt(s).
+static void ps2_push_event(uint8_t code, uint8_t flags, uint32_t rx_us) {
+    uint8_t head = g_ps2_head;
+
+    if ((uint8_t)(head - g_ps2_tail) >= PS2_EVENT_RING_SIZE) {
+        g_ps2_overflow_count++;
+        trace_log(TRACE_PS2_OVERFLOW, g_ps2_overflow_count);
         return;
     }
 
-    uint8_t local_req[3];
-    uint8_t local_len;
+    ps2_event_t *ev = &g_ps2_ring[head & PS2_EVENT_RING_MASK];
+    ev->rx_us = rx_us;
+    ev->code  = code;
+    ev->flags = flags;
+
+    // Publish the slot only after its contents are written
+    __DMB();
+    g_ps2_head = head + 1;
+}
+
+// Run one received byte through the prefix state-transition table and queue
+// the event if it completes a sequence. Shared by the ISR and DMA paths.
+static void ps2_feed_byte(uint8_t b) {
+    static uint8_t  state = PS2_STATE_IDLE;
+    static uint32_t seq_rx_us;
+
+    // A sequence is stamped with the arrival of its first byte
+    if (state == PS2_STATE_IDLE) {
+        seq_rx_us = timebase_now_us();
+    }
+
+    ps2_transition_t t = ps2_set2_transitions[state][ps2_byte_class(b)];
+    state = PS2_T_NEXT(t);
 
-    // Critical section: copy the mailbox and clear the flag
-    __disable_irq();
-    local_len = g_ps2_len;
-    for (uint8_t i = 0; i < local_len; i++) {
-        local_req[i] = g_ps2_req[i];
+    if (PS2_T_EMIT(t)) {
+        trace_log(TRACE_PS2_EVENT, b | (PS2_T_FLAGS(t) << 8));
+        ps2_push_event(b, PS2_T_FLAGS(t), seq_rx_us);
     }
-    g_ps2_event_ready = 0;
-    __enable_irq();
+}
+
+#if PS2_USE_DMA
+
+/* ---------------- USART1 RX via circular DMA ---------------- */
+
+// DMA1 channel 5, request 2 = USART1_RX (RM0394 table 41)
+#define PS2_DMA_CHANNEL     DMA1_Channel5
+#define PS2_DMA_REQUEST     2
+
+// Must hold more bytes than can arrive between two half-transfer interrupts
+#define PS2_DMA_BUF_SIZE    64
+
+static volatile uint8_t g_ps2_dma_buf[PS2_DMA_BUF_SIZE];
+
+// Next buffer index the assembler has not consumed yet
+static uint16_t g_ps2_dma_read_pos = 0;
+
+void keyboard_init_rx(void) {
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+
+    // Route USART1_RX to channel 5
+    DMA1_CSELR->CSELR &= ~DMA_CSELR_C5S;
+    DMA1_CSELR->CSELR |= (PS2_DMA_REQUEST << DMA_CSELR_C5S_Pos);
+
+    // Peripheral -> memory, 8-bit both sides, memory increment, circular,
+    // interrupt at half and full buffer
+    PS2_DMA_CHANNEL->CCR   = 0;
+    PS2_DMA_CHANNEL->CPAR  = (uint32_t) &USART1->RDR;
+    PS2_DMA_CHANNEL->CMAR  = (uint32_t) g_ps2_dma_buf;
+    PS2_DMA_CHANNEL->CNDTR = PS2_DMA_BUF_SIZE;
+    PS2_DMA_CHANNEL->CCR   = DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE;
+    PS2_DMA_CHANNEL->CCR  |= DMA_CCR_EN;
+
+    // USART1 raises DMA requests instead of RXNE interrupts; the idle-line
+    // interrupt flushes a sequence that stops short of a half buffer
+    USART1->ICR  = USART_ICR_IDLECF;
+    USART1->CR3 |= USART_CR3_DMAR;
+    USART1->CR1 |= USART_CR1_IDLEIE;
 
-    // Now decode and update keyboard state outside the ISR
-    keyboard_update_state(local_req, local_len);
+    // Both handlers call ps2_dma_process(); equal priority keeps them from
+    // preempting each other
+    NVIC_SetPriority(DMA1_Channel5_IRQn, NVIC_GetPriority(USART1_IRQn));
+    NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+    NVIC_EnableIRQ(USART1_IRQn);
 }
 
-/* ---------------- USART1 ISR (PS/2 byte assembler) ---------------- */
-// Interrupt handler that assembles PS/2 Scan Code
-// Set up to 3 events into a small global mailbox (g_ps2) consumed by scanKeyboard().
-// includes global mailbox variables ps2_req, ps2_len, ps2_event_ready.
+// Feed every byte the DMA has written since the last call to the assembler
+static void ps2_dma_process(void) {
+    g_ps2_irq_count++;
+
+    uint16_t write_pos = PS2_DMA_BUF_SIZE - (uint16_t) PS2_DMA_CHANNEL->CNDTR;
+    if (write_pos == PS2_DMA_BUF_SIZE) {
+        write_pos = 0;  // CNDTR reloads from 0 to SIZE on wrap
+    }
+
+    while (g_ps2_dma_read_pos != write_pos) {
+        ps2_feed_byte(g_ps2_dma_buf[g_ps2_dma_read_pos]);
+        if (++g_ps2_dma_read_pos == PS2_DMA_BUF_SIZE) {
+            g_ps2_dma_read_pos = 0;
+        }
+    }
+}
+
+// Half / full transfer: a batch of bytes is waiting in the buffer
+void DMA1_Channel5_IRQHandler(void) {
+    DMA1->IFCR = DMA_IFCR_CGIF5;
+    ps2_dma_process();
+}
+
+// Idle line: the keyboard has paused, consume whatever arrived so far
+void USART1_IRQHandler(void) {
+    if (USART1->ISR & USART_ISR_IDLE) {
+        USART1->ICR = USART_ICR_IDLECF;
+        ps2_dma_process();
+    }
+}
+
+#else
+
+/* ---------------- USART1 RX, one interrupt per byte ---------------- */
+
+void keyboard_init_rx(void) {
+    // Enable RXNE interrupt on USART1
+    USART1->CR1 |= USART_CR1_RXNEIE;
+    NVIC_EnableIRQ(USART1_IRQn);
+}
+
+// Interrupt handler that assembles PS/2 Scan Code Set 2 sequences with the
+// prefix state-transition table and queues each completed one in the ring.
 void USART1_IRQHandler(void) {
     // Read status and data if RXNE is set
     if (USART1->ISR & USART_ISR_RXNE) {
-        uint8_t b = (uint8_t) USART1->RDR;  // reading RDR clears RXNE
-
-        // Simple state machine to assemble Scan Code Set 2 sequences
-        static uint8_t acc[3];
-        static uint8_t acc_len = 0;
-
-        if (acc_len == 0) {
-            acc[0]  = b;
-            acc_len = 1;
-
-            // Simple 1-byte make (no prefix)
-            if (b != 0xE0 && b != 0xF0) {
-                if (!g_ps2_event_ready) {
-                    g_ps2_req[0]      = b;
-                    g_ps2_len         = 1;
-                    g_ps2_event_ready = 1;
-                }
-                acc_len = 0;
-            }
-        } else if (acc_len == 1) {
-            acc[1]  = b;
-            acc_len = 2;
-
-            if (acc[0] == 0xE0) {
-                // [0xE0, code] extended make OR [0xE0, 0xF0] extended break prefix
-                if (b == 0xF0) {
-                    // Extended break prefix, need one more byte
-                    // keep acc_len = 2
-                } else {
-                    // Extended make: [0xE0, code]
-                    if (!g_ps2_event_ready) {
-                        g_ps2_req[0]      = 0xE0;
-                        g_ps2_req[1]      = b;
-                        g_ps2_len         = 2;
-                        g_ps2_event_ready = 1;
-                    }
-                    acc_len = 0;
-                }
-            } else if (acc[0] == 0xF0) {
-                // Normal break: [0xF0, code]
-                if (!g_ps2_event_ready) {
-                    g_ps2_req[0]      = 0xF0;
-                    g_ps2_req[1]      = b;
-                    g_ps2_len         = 2;
-                    g_ps2_event_ready = 1;
-                }
-                acc_len = 0;
-            } else {
-                // Unexpected, treat second byte as standalone
-                if (!g_ps2_event_ready) {
-                    g_ps2_req[0]      = b;
-                    g_ps2_len         = 1;
-                    g_ps2_event_ready = 1;
-                }
-                acc_len = 0;
-            }
-        } else if (acc_len == 2) {
-            acc[2] = b;
-
-            // Extended break: [0xE0, 0xF0, code]
-            if (acc[0] == 0xE0 && acc[1] == 0xF0) {
-                if (!g_ps2_event_ready) {
-                    g_ps2_req[0]      = 0xE0;
-                    g_ps2_req[1]      = 0xF0;
-                    g_ps2_req[2]      = b;
-                    g_ps2_len         = 3;
-                    g_ps2_event_ready = 1;
-                }
-            }
-
-            // Done
-            acc_len = 0;
-        }
+        g_ps2_irq_count++;
+        ps2_feed_byte((uint8_t) USART1->RDR);  // reading RDR clears RXNE
     }
 }
+
+#endif // PS2_USE_DMA
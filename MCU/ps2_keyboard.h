@@ -3,29 +3,79 @@
 
 #include <stdint.h>
 
+// PS/2 receive mode (select with -DPS2_USE_DMA=1):
+//   0 = USART1 RXNE interrupt per byte
+//   1 = USART1 RX into a circular DMA buffer (DMA1 channel 5), decoded in
+//       batches on half/full transfer and idle-line interrupts
+#ifndef PS2_USE_DMA
+#define PS2_USE_DMA 0
+#endif
+
 /**
- * Update internal keyboard state from a PS/2 scan-code event.
- * Usually you do not call this directly; call scanKeyboard() from main.
+ * Start PS/2 reception on USART1 in the PS2_USE_DMA mode and enable the
+ * interrupts it needs. initUSART(USART1_ID, ...) must run first.
  */
-void keyboard_update_state(const uint8_t *request, int req_len);
+void keyboard_init_rx(void);
 
 /**
- * Returns non-zero if this key is currently considered "pressed"
- * according to the latched keyboard state.
+ * Update internal keyboard state from a PS/2 scan-code event:
+ * code is the last byte of the sequence, flags are PS2_FLAG_* from
+ * ps2_scancodes.h. Usually you do not call this directly; call
+ * scanKeyboard() from main.
+ */
+void keyboard_update_state(uint8_t code, uint8_t flags);
+
+/**
+ * Returns non-zero while this key is held down.
  */
 uint8_t keyboard_get_key_state(char key);
 
 /**
- * Called from main loop to pull a completed PS/2 event out of the
- * ISR mailbox and feed it into keyboard_update_state().
+ * Returns 1 once for every press of this key (0 -> 1 transition) and
+ * clears the latch, so taps released before the caller polls are not lost.
+ * Safe to call from an ISR that preempts scanKeyboard().
+ */
+uint8_t keyboard_take_key_press(char key);
+
+/**
+ * Timestamps (timebase_now_us()) of the latest press of key: when its first
+ * PS/2 byte was received and when scanKeyboard() processed it. With
+ * PS2_USE_DMA=1 "received" means when the DMA batch was decoded.
+ */
+void keyboard_get_press_stamps(char key, uint32_t *rx_us, uint32_t *scan_us);
+
+/**
+ * Called from main loop to drain every completed PS/2 event queued by
+ * the ISR and feed each one into keyboard_update_state(), in order.
  */
 void scanKeyboard(void);
 
+/**
+ * Number of PS/2 events dropped because the ISR event ring was full
+ * (scanKeyboard() not called often enough). Monotonic, never reset.
+ */
+uint32_t keyboard_get_overflow_count(void);
+
+/**
+ * Receive interrupts taken since reset (per byte with PS2_USE_DMA=0,
+ * per batch with PS2_USE_DMA=1). For comparing the two modes.
+ */
+uint32_t keyboard_get_irq_count(void);
+
 /**
  * USART1 interrupt handler that assembles PS/2 Scan Code Set 2 events
- * into a small mailbox consumed by scanKeyboard().
+ * into a lock-free event ring consumed by scanKeyboard(). In DMA mode it
+ * only handles the idle-line interrupt.
  * (Name must match the vector table.)
  */
 void USART1_IRQHandler(void);
 
+#if PS2_USE_DMA
+/**
+ * DMA half/full transfer interrupt for the PS/2 receive buffer.
+ * (Name must match the vector table.)
+ */
+void DMA1_Channel5_IRQHandler(void);
+#endif
+
 #endif // PS2_KEYBOARD_H
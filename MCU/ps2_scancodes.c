@@ -0,0 +1,70 @@
+/*
+ * ps2_scancodes.c
+ * Scan Code Set 2 decode tables and prefix state-transition table.
+ */
+
+#include <stdint.h>
+
+#include "ps2_scancodes.h"
+
+/* ---------------- Prefix state machine ---------------- */
+
+// Sequences we assemble:
+//   Make (normal):        [code]
+//   Make (extended):      [0xE0, code]
+//   Break (normal):       [0xF0, code]
+//   Break (extended):     [0xE0, 0xF0, code]
+// A prefix byte where a code is expected is treated as the code itself
+// (it decodes to an unmapped key), which keeps the machine in sync.
+#define EXT_BRK (PS2_FLAG_EXTENDED | PS2_FLAG_BREAK)
+
+const ps2_transition_t ps2_set2_transitions[PS2_NUM_STATES][PS2_NUM_CLASSES] = {
+    //                    CODE                                         E0                                           F0
+    [PS2_STATE_IDLE]  = { PS2_T(PS2_STATE_IDLE, 1, 0),                 PS2_T(PS2_STATE_E0,   0, 0),                 PS2_T(PS2_STATE_F0,    0, 0)       },
+    [PS2_STATE_E0]    = { PS2_T(PS2_STATE_IDLE, 1, PS2_FLAG_EXTENDED), PS2_T(PS2_STATE_IDLE, 1, PS2_FLAG_EXTENDED), PS2_T(PS2_STATE_E0_F0, 0, 0)       },
+    [PS2_STATE_F0]    = { PS2_T(PS2_STATE_IDLE, 1, PS2_FLAG_BREAK),    PS2_T(PS2_STATE_IDLE, 1, PS2_FLAG_BREAK),    PS2_T(PS2_STATE_IDLE,  1, PS2_FLAG_BREAK) },
+    [PS2_STATE_E0_F0] = { PS2_T(PS2_STATE_IDLE, 1, EXT_BRK),           PS2_T(PS2_STATE_IDLE, 1, EXT_BRK),           PS2_T(PS2_STATE_IDLE,  1, EXT_BRK)  },
+};
+
+#undef EXT_BRK
+
+/* ---------------- Set 2 -> printable char ---------------- */
+
+// Printable ASCII-ish keys (letters, digits, punctuation, space).
+// Shared by both tables: an E0-prefixed code with no dedicated entry
+// decodes like its plain counterpart (e.g. keypad Enter -> '\n').
+#define PS2_SET2_PRINTABLE_KEYS                                          \
+    /* Row: ` 1 2 3 4 5 6 7 8 9 0 - = */                                 \
+    [0x0E] = '`',  [0x16] = '1',  [0x1E] = '2',  [0x26] = '3',           \
+    [0x25] = '4',  [0x2E] = '5',  [0x36] = '6',  [0x3D] = '7',           \
+    [0x3E] = '8',  [0x46] = '9',  [0x45] = '0',  [0x4E] = '-',           \
+    [0x55] = '=',                                                        \
+    /* Row: Q W E R T Y U I O P [ ] */                                   \
+    [0x15] = 'Q',  [0x1D] = 'W',  [0x24] = 'E',  [0x2D] = 'R',           \
+    [0x2C] = 'T',  [0x35] = 'Y',  [0x3C] = 'U',  [0x43] = 'I',           \
+    [0x44] = 'O',  [0x4D] = 'P',  [0x54] = '[',  [0x5B] = ']',           \
+    /* Row: A S D F G H J K L ; ' and backslash */                       \
+    [0x1C] = 'A',  [0x1B] = 'S',  [0x23] = 'D',  [0x2B] = 'F',           \
+    [0x34] = 'G',  [0x33] = 'H',  [0x3B] = 'J',  [0x42] = 'K',           \
+    [0x4B] = 'L',  [0x4C] = ';',  [0x52] = '\'', [0x5D] = '\\',          \
+    /* Row: Z X C V B N M , . / */                                       \
+    [0x1A] = 'Z',  [0x22] = 'X',  [0x21] = 'C',  [0x2A] = 'V',           \
+    [0x32] = 'B',  [0x31] = 'N',  [0x3A] = 'M',  [0x41] = ',',           \
+    [0x49] = '.',  [0x4A] = '/',                                         \
+    /* Space and control-ish keys mapped to common chars */              \
+    [0x29] = ' ',  [0x5A] = '\n', [0x0D] = '\t', [0x66] = '\b',          \
+    [0x76] = 27  /* ESC */
+
+const char ps2_set2_plain[256] = {
+    PS2_SET2_PRINTABLE_KEYS,
+};
+
+const char ps2_set2_extended[256] = {
+    PS2_SET2_PRINTABLE_KEYS,
+
+    // Arrow keys only exist behind the 0xE0 prefix
+    [0x75] = '^',  // Up arrow
+    [0x72] = 'v',  // Down arrow
+    [0x6B] = '<',  // Left arrow
+    [0x74] = '>',  // Right arrow
+};
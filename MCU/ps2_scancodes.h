@@ -0,0 +1,62 @@
+#ifndef PS2_SCANCODES_H
+#define PS2_SCANCODES_H
+
+/*
+ * ps2_scancodes.h
+ * Flash-resident lookup tables for PS/2 Scan Code Set 2.
+ *
+ * Nothing in here touches hardware, so the same tables can be linked
+ * into host-side tools (see tools/ps2_decode_bench.c).
+ */
+
+#include <stdint.h>
+
+// Flags attached to every completed event by the prefix state machine
+#define PS2_FLAG_EXTENDED 0x01  // sequence started with 0xE0
+#define PS2_FLAG_BREAK    0x02  // sequence contained 0xF0 (key release)
+
+// Prefix state machine states (which prefix bytes have been seen so far)
+typedef enum {
+    PS2_STATE_IDLE = 0,  // waiting for the first byte of a sequence
+    PS2_STATE_E0,        // seen 0xE0
+    PS2_STATE_F0,        // seen 0xF0
+    PS2_STATE_E0_F0,     // seen 0xE0 0xF0
+    PS2_NUM_STATES
+} ps2_prefix_state_t;
+
+// Input byte classes fed to the state machine
+typedef enum {
+    PS2_CLASS_CODE = 0,  // any byte that is not a prefix
+    PS2_CLASS_E0,        // 0xE0 extended prefix
+    PS2_CLASS_F0,        // 0xF0 break prefix
+    PS2_NUM_CLASSES
+} ps2_byte_class_t;
+
+// One transition packed into a byte so the ISR does a single 8-bit load:
+//   bits 1..0 : next ps2_prefix_state_t
+//   bit  2    : this byte completes an event
+//   bits 4..3 : PS2_FLAG_* of the emitted event
+typedef uint8_t ps2_transition_t;
+
+#define PS2_T_NEXT(t)   ((t) & 0x03)
+#define PS2_T_EMIT(t)   ((t) & 0x04)
+#define PS2_T_FLAGS(t)  (((t) >> 3) & 0x03)
+#define PS2_T(next, emit, flags) ((ps2_transition_t)((next) | ((emit) << 2) | ((flags) << 3)))
+
+// t = ps2_set2_transitions[state][ps2_byte_class(byte)]
+extern const ps2_transition_t ps2_set2_transitions[PS2_NUM_STATES][PS2_NUM_CLASSES];
+
+// Make code -> key character (0 = unmapped), without and with the 0xE0 prefix
+extern const char ps2_set2_plain[256];
+extern const char ps2_set2_extended[256];
+
+static inline uint8_t ps2_byte_class(uint8_t b) {
+    return (b == 0xE0) ? PS2_CLASS_E0 : (b == 0xF0) ? PS2_CLASS_F0 : PS2_CLASS_CODE;
+}
+
+// Map a completed event (last byte + flags) to its key character
+static inline char ps2_set2_lookup(uint8_t code, uint8_t flags) {
+    return (flags & PS2_FLAG_EXTENDED) ? ps2_set2_extended[code] : ps2_set2_plain[code];
+}
+
+#endif // PS2_SCANCODES_H
@@ -1,54 +1,223 @@
 /*
  * spi_protocol.c
- * Random-field management + SPI word packing and parity.
+ * Framed SPI protocol (header, opcodes, CRC-8), sent through the DMA
+ * transmit queue.
  */
 
 #include <stdint.h>
 
-#include "STM32L432KC_SPI.h"
-#include "random.h"
 #include "stm32l4xx.h"
 #include "spi_protocol.h"
+#include "spi_tx_queue.h"
+#include "latency.h"
+#include "timebase.h"
+#include "trace.h"
 
-// 3-bit random value used in the SPI payload (0..6).
-static volatile uint8_t g_random3 = 0;
+#if SPI_TRANSFER_MAX_LEN > SPI_TX_MAX_LEN
+#error "SPI_TX_MAX_LEN too small for a frame or status reply"
+#endif
 
-// Compute even parity of an 8-bit value.
-static uint8_t compute_parity(uint8_t x) {
-    uint8_t p = 0;
-    for (int i = 0; i < 8; ++i) {
-        p ^= (x & 0x01);
-        x >>= 1;
+// Sequence number of the next frame
+static uint8_t g_frame_seq = 0;
+
+// Mirror of the FPGA status, written only by spi_service()
+static spi_status_t g_spi_status;
+
+// CRC-8 poly 0x07, one nibble at a time
+static const uint8_t crc8_nibble_table[16] = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
+    0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
+};
+
+static uint8_t crc8_update(uint8_t crc, uint8_t byte) {
+    crc ^= byte;
+    crc = (uint8_t)(crc << 4) ^ crc8_nibble_table[crc >> 4];
+    crc = (uint8_t)(crc << 4) ^ crc8_nibble_table[crc >> 4];
+    return crc;
+}
+
+uint8_t spi_crc8(const uint8_t *data, uint8_t len) {
+    uint8_t crc = 0x00;
+    for (uint8_t i = 0; i < len; i++) {
+        crc = crc8_update(crc, data[i]);
     }
-    return p;  // 0 if even # of 1s, 1 if odd # of 1s
+    return crc;
 }
 
-void update_random3(void) {
-    uint32_t r;
-    uint8_t  v;
+void spi_frame_init(spi_frame_t *frame) {
+    frame->len = 0;
+}
 
-    do {
-        r = getRandomNumber();
-        v = r & 0x07;
-    } while (v == 7);    // avoid 7
+uint8_t spi_frame_add(spi_frame_t *frame, spi_opcode_t op,
+                      const uint8_t *args, uint8_t nargs) {
+    if (frame->len + 1 + nargs > SPI_FRAME_MAX_PAYLOAD) {
+        return 0;
+    }
 
-    g_random3 = v;
+    frame->payload[frame->len++] = (uint8_t) op;
+    for (uint8_t i = 0; i < nargs; i++) {
+        frame->payload[frame->len++] = args[i];
+    }
+    return 1;
 }
 
-void send_spi_word(uint8_t key_pressed, uint8_t key_value) {
-    // First build the payload (no parity yet)
-    uint8_t payload =
-        (uint8_t)( ((key_pressed & 0x01) << 5) |   // bit 5
-                   (( g_random3  & 0x07) << 2) |   // bits 4..2
-                   ( key_value   & 0x03) );        // bits 1..0
+// Serialise frame and queue it for DMA; tag comes back in spi_service()
+static uint8_t spi_frame_queue(const spi_frame_t *frame, uint32_t tag) {
+    uint8_t bytes[SPI_TRANSFER_MAX_LEN];
+    uint8_t n = 0;
+
+    bytes[n++] = (uint8_t)(SPI_FRAME_VERSION << 4);
+    bytes[n++] = g_frame_seq;
+    bytes[n++] = frame->len;
+    for (uint8_t i = 0; i < frame->len; i++) {
+        bytes[n++] = frame->payload[i];
+    }
+    uint8_t crc = spi_crc8(bytes, n);
+    bytes[n++] = crc;
+
+    // Keep clocking until the whole status reply is in
+    while (n < SPI_STATUS_LEN) {
+        bytes[n++] = 0x00;
+    }
 
-    // Compute even parity over the payload bits
-    uint8_t parity_bit = compute_parity(payload);  // 0 or 1
+    if (!spi_tx_queue_push(bytes, n, tag)) {
+        trace_log(TRACE_SPI_FULL, spi_tx_queue_get_full_count());
+        return 0;
+    }
+
+    // Only frames that reach the wire use up a sequence number, so the
+    // FPGA's missed-frame count reflects the link alone
+    trace_log(TRACE_SPI_FRAME, g_frame_seq | (frame->len << 8) | ((uint32_t) crc << 16));
+    g_frame_seq++;
+    return 1;
+}
+
+uint8_t spi_frame_send(const spi_frame_t *frame) {
+    return spi_frame_queue(frame, 0);
+}
+
+uint8_t send_spi_moves(const uint8_t *key_values, uint8_t count) {
+    spi_frame_t frame;
+
+    if (count > SPI_FRAME_MAX_MOVES) {
+        count = SPI_FRAME_MAX_MOVES;
+    }
+
+    spi_frame_init(&frame);
+    for (uint8_t i = 0; i < count; i++) {
+        if (key_values[i] == SPI_KEY_HARD_DROP) {
+            spi_frame_add(&frame, SPI_OP_HARD_DROP, 0, 0);
+        } else if (key_values[i] == SPI_KEY_HOLD) {
+            spi_frame_add(&frame, SPI_OP_HOLD, 0, 0);
+        } else {
+            uint8_t key_value = key_values[i] & 0x03;
+            spi_frame_add(&frame, SPI_OP_MOVE, &key_value, 1);
+        }
+    }
+
+    // Tag: one bit per command in the frame, for the latency histograms
+    uint32_t commands = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        commands |= 1u << (key_values[i] & (LATENCY_NUM_COMMANDS - 1));
+    }
+    return spi_frame_queue(&frame, commands);
+}
 
-    // Put parity in MSB (bit 7). bit 6 stays 0.
-    uint8_t word = (uint8_t)((parity_bit << 7) | payload);
+uint8_t spi_send_seed(uint32_t seed) {
+    spi_frame_t frame;
+    uint8_t     args[4] = {
+        (uint8_t) seed, (uint8_t)(seed >> 8), (uint8_t)(seed >> 16), (uint8_t)(seed >> 24),
+    };
+
+    spi_frame_init(&frame);
+    spi_frame_add(&frame, SPI_OP_SEED, args, 4);
+    return spi_frame_queue(&frame, 0);
+}
+
+uint8_t spi_send_config(uint8_t reg, uint8_t value) {
+    spi_frame_t frame;
+    uint8_t     args[2] = { reg, value };
+
+    spi_frame_init(&frame);
+    spi_frame_add(&frame, SPI_OP_CONFIG, args, 2);
+    return spi_frame_queue(&frame, 0);
+}
+
+uint8_t spi_send_soft_drop(uint8_t held) {
+    spi_frame_t frame;
+    uint8_t     arg = held ? 1 : 0;
+
+    spi_frame_init(&frame);
+    spi_frame_add(&frame, SPI_OP_SOFT_DROP, &arg, 1);
+    return spi_frame_queue(&frame, 0);
+}
+
+uint8_t spi_send_gravity_table(const uint8_t *frames_per_row) {
+    spi_frame_t frame;
+    uint8_t     level = 0;
+
+    while (level < SPI_GRAVITY_LEVELS) {
+        spi_frame_init(&frame);
+        for (; level < SPI_GRAVITY_LEVELS; level++) {
+            uint8_t args[2] = { (uint8_t)(SPI_CFG_GRAVITY + level), frames_per_row[level] };
+            if (!spi_frame_add(&frame, SPI_OP_CONFIG, args, 2)) {
+                break;
+            }
+        }
+        if (!spi_frame_queue(&frame, 0)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+uint8_t spi_poll_status(void) {
+    spi_frame_t frame;
+    spi_frame_init(&frame);
+    return spi_frame_queue(&frame, 0);
+}
+
+// Check and unpack one status reply into the mirror
+static void spi_parse_status(const uint8_t *rx, uint32_t rx_us) {
+    spi_status_t *s = &g_spi_status;
+
+    if ((rx[SPI_ST_HEADER] >> 4) != SPI_STATUS_VERSION ||
+        spi_crc8(rx, SPI_ST_CRC) != rx[SPI_ST_CRC]) {
+        s->bad_frames++;
+        return;
+    }
+
+    s->piece_type     = rx[SPI_ST_PIECE] & 0x07;
+    s->piece_rotation = (rx[SPI_ST_PIECE] >> 4) & 0x03;
+    s->piece_x        = rx[SPI_ST_PIECE_X];
+    s->piece_y        = rx[SPI_ST_PIECE_Y];
+    s->lines_cleared  = (uint16_t)(rx[SPI_ST_LINES] | (rx[SPI_ST_LINES + 1] << 8));
+    for (uint8_t x = 0; x < SPI_BOARD_WIDTH; x++) {
+        s->column_heights[x] = rx[SPI_ST_HEIGHTS + x];
+    }
+    s->game_overs     = rx[SPI_ST_GAME_OVERS];
+    s->cmd_drops      = rx[SPI_ST_CMD_DROPS];
+    s->crc_errors     = rx[SPI_ST_CRC_ERRORS];
+    s->missed_frames  = rx[SPI_ST_MISSED];
+    s->updated_us     = rx_us;
+    s->updates++;
+}
+
+void spi_service(void) {
+    spi_tx_done_t done;
+
+    while (spi_tx_queue_take_done(&done)) {
+        for (uint8_t command = 0; command < LATENCY_NUM_COMMANDS; command++) {
+            if (done.tag & (1u << command)) {
+                latency_on_spi_send(command, done.done_us);
+            }
+        }
+        if (done.len >= SPI_STATUS_LEN) {
+            spi_parse_status(done.rx, done.done_us);
+        }
+    }
+}
 
-    enable_cs();
-    spiSendReceive(word);   // 0xFF & word is redundant here
-    disable_cs();
+const spi_status_t *spi_get_status(void) {
+    return &g_spi_status;
 }
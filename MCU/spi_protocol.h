@@ -3,20 +3,174 @@
 
 #include <stdint.h>
 
+/*
+ * Framed MCU -> FPGA SPI protocol, one frame per chip-enable:
+ *
+ *   byte 0    : version << 4 (low nibble: flags, reserved 0)
+ *   byte 1    : sequence number, +1 per frame (mod 256)
+ *   byte 2    : payload length (0..SPI_FRAME_MAX_PAYLOAD)
+ *   payload   : opcodes, each followed by its argument bytes
+ *   last byte : CRC-8 (poly 0x07, init 0x00) over header + payload
+ *
+ * Must match FPGA/src/spi_frame_pkg.sv. The FPGA drops frames with a bad
+ * CRC and counts sequence gaps as missed frames.
+ *
+ * Full duplex: while a frame goes out, the FPGA shifts back a status frame
+ * of SPI_STATUS_LEN bytes (game state as of the start of the transfer, last
+ * byte a CRC-8 over the rest). Frames are padded with 0x00 to that length,
+ * and spi_service() parses each reply into the mirror from spi_get_status().
+ */
+
+#define SPI_FRAME_VERSION      1
+#define SPI_FRAME_MAX_PAYLOAD  16
+#define SPI_FRAME_HEADER_LEN   3
+#define SPI_FRAME_MAX_LEN      (SPI_FRAME_HEADER_LEN + SPI_FRAME_MAX_PAYLOAD + 1)
+
+// Status frame, FPGA -> MCU (byte offsets, see spi_frame_pkg.sv)
+#define SPI_STATUS_VERSION     1
+#define SPI_STATUS_LEN         21
+#define SPI_BOARD_WIDTH        10
+
+#define SPI_ST_HEADER          0
+#define SPI_ST_PIECE           1   // rotation << 4 | piece type
+#define SPI_ST_PIECE_X         2
+#define SPI_ST_PIECE_Y         3
+#define SPI_ST_LINES           4   // 16-bit little endian
+#define SPI_ST_HEIGHTS         6   // SPI_BOARD_WIDTH bytes
+#define SPI_ST_GAME_OVERS      16
+#define SPI_ST_CMD_DROPS       17
+#define SPI_ST_CRC_ERRORS      18
+#define SPI_ST_MISSED          19
+#define SPI_ST_CRC             20
+
+// Longest transfer: a full frame, or the status reply if that is longer
+#define SPI_TRANSFER_MAX_LEN   (SPI_FRAME_MAX_LEN > SPI_STATUS_LEN ? SPI_FRAME_MAX_LEN : SPI_STATUS_LEN)
+
+// Most moves send_spi_moves() puts in one frame: up to two bytes per move
+// must fit the payload
+#define SPI_FRAME_MAX_MOVES    (SPI_FRAME_MAX_PAYLOAD / 2)
+
+// key_values that send_spi_moves() sends as their own opcodes instead of a move
+#define SPI_KEY_HARD_DROP      4
+#define SPI_KEY_HOLD           5
+
+typedef enum {
+    SPI_OP_NOP       = 0x00,  // no arguments
+    SPI_OP_MOVE      = 0x01,  // arg: key_value (1 Up, 0 Down, 2 Left, 3 Right)
+    SPI_OP_HARD_DROP = 0x02,  // no arguments
+    SPI_OP_PIECE_RNG = 0x03,  // arg: random piece value 0..6 (unused by the FPGA)
+    SPI_OP_SEED      = 0x04,  // args: 32-bit seed, little endian
+    SPI_OP_CONFIG    = 0x05,  // args: register, value
+    SPI_OP_HOLD      = 0x06,  // no arguments
+    SPI_OP_SOFT_DROP = 0x07,  // arg: 1 key pressed, 0 released
+} spi_opcode_t;
+
+// SPI_OP_CONFIG registers (spi_frame_pkg CFG_*)
+#define SPI_GRAVITY_LEVELS       32
+#define SPI_CFG_GRAVITY          0x00  // + level: frames per row, 0 = 20G
+#define SPI_CFG_LINES_PER_LEVEL  0x20  // lines to the next level (0 = 1)
+#define SPI_CFG_START_LEVEL      0x21  // level after a game over; also applied at once
+#define SPI_CFG_LOCK_FRAMES      0x22  // frames a landed piece waits before locking
+#define SPI_CFG_LOCK_RESETS      0x23  // moves per piece that restart the lock delay
+#define SPI_CFG_SOFT_DROP        0x24  // gravity multiplier while soft drop is held (0 = 1)
+
+// Mirror of the FPGA game state, refreshed by every SPI transfer
+typedef struct {
+    uint32_t updates;          // good status frames received
+    uint32_t bad_frames;       // replies with a bad CRC or version
+    uint32_t updated_us;       // timebase_now_us() of the last good one
+    uint8_t  piece_type;       // tetris_pkg::piece_type_t
+    uint8_t  piece_rotation;   // 0..3 = 0, 90, 180, 270 degrees
+    uint8_t  piece_x;
+    uint8_t  piece_y;
+    uint16_t lines_cleared;
+    uint8_t  column_heights[SPI_BOARD_WIDTH];  // 0 (empty) .. 20
+    uint8_t  game_overs;       // FPGA counters, wrap at 256
+    uint8_t  cmd_drops;
+    uint8_t  crc_errors;
+    uint8_t  missed_frames;
+} spi_status_t;
+
+// Payload under construction
+typedef struct {
+    uint8_t len;
+    uint8_t payload[SPI_FRAME_MAX_PAYLOAD];
+} spi_frame_t;
+
+/**
+ * Queue one SPI_OP_SEED frame. The FPGA seeds its 7-bag piece generator
+ * with it and restarts the next-piece queue. Returns 0 if the transmit
+ * queue was full.
+ */
+uint8_t spi_send_seed(uint32_t seed);
+
+/**
+ * Queue one SPI_OP_CONFIG write of value to FPGA register reg (SPI_CFG_*).
+ * Returns 0 if the transmit queue was full.
+ */
+uint8_t spi_send_config(uint8_t reg, uint8_t value);
+
+/**
+ * Queue one SPI_OP_SOFT_DROP frame: held = 1 when the soft drop key goes
+ * down, 0 when it comes up. The FPGA runs gravity SPI_CFG_SOFT_DROP times
+ * faster in between. Returns 0 if the transmit queue was full.
+ */
+uint8_t spi_send_soft_drop(uint8_t held);
+
+/**
+ * Load a whole gravity curve: SPI_GRAVITY_LEVELS frames-per-row entries,
+ * level 0 first (all 0 = 20G). Packs as many writes per frame as fit,
+ * which is 7 frames, so call it while the transmit queue is mostly empty.
+ * Returns 0 if the transmit queue filled up part way.
+ */
+uint8_t spi_send_gravity_table(const uint8_t *frames_per_row);
+
+/**
+ * CRC-8 (poly 0x07, init 0x00) of len bytes.
+ */
+uint8_t spi_crc8(const uint8_t *data, uint8_t len);
+
+/**
+ * Start an empty frame.
+ */
+void spi_frame_init(spi_frame_t *frame);
+
+/**
+ * Append one opcode and its nargs argument bytes. Returns 0 (and leaves
+ * the frame unchanged) if it does not fit.
+ */
+uint8_t spi_frame_add(spi_frame_t *frame, spi_opcode_t op,
+                      const uint8_t *args, uint8_t nargs);
+
+/**
+ * Add header and CRC and queue the frame for sending under one
+ * chip-enable. Returns at once; 0 if the transmit queue was full.
+ */
+uint8_t spi_frame_send(const spi_frame_t *frame);
+
+/**
+ * Queue up to SPI_FRAME_MAX_MOVES moves (key_value each) in one frame.
+ * SPI_KEY_HARD_DROP and
+ * SPI_KEY_HOLD entries go out as SPI_OP_HARD_DROP and SPI_OP_HOLD. Extra
+ * entries are ignored.
+ * Returns 0 if the transmit queue was full.
+ */
+uint8_t send_spi_moves(const uint8_t *key_values, uint8_t count);
+
+/**
+ * Queue an empty frame, only to fetch a fresh status reply.
+ */
+uint8_t spi_poll_status(void);
+
 /**
- * Update the 3-bit random value used in the SPI word.
- * Keeps the value in an internal module-global.
+ * Collect frames the DMA has finished sending: close their latency
+ * measurements and update the status mirror. Call from the main loop.
  */
-void update_random3(void);
+void spi_service(void);
 
 /**
- * Pack a SPI word with:
- *   bit 7 : even parity over bits 6..0
- *   bit 6 : 0
- *   bit 5 : key_pressed (0/1)
- *   bits 4..2 : 3-bit random value (0..6)
- *   bits 1..0 : key_value (0..3 encoding ^ v < >)
+ * Latest FPGA status. Only changes inside spi_service().
  */
-void send_spi_word(uint8_t key_pressed, uint8_t key_value);
+const spi_status_t *spi_get_status(void);
 
 #endif // SPI_PROTOCOL_H
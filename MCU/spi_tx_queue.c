@@ -0,0 +1,164 @@
+/*
+ * spi_tx_queue.c
+ * DMA-driven SPI1 transmit queue with chip-enable handled in the
+ * completion interrupt.
+ */
+
+#include <stdint.h>
+
+#include "stm32l4xx.h"
+#include "STM32L432KC_SPI.h"
+#include "spi_tx_queue.h"
+#include "timebase.h"
+
+// DMA1 request 1 = SPI1 on channels 2 (RX) and 3 (TX) (RM0394 table 41)
+#define SPI_DMA_RX          DMA1_Channel2
+#define SPI_DMA_TX          DMA1_Channel3
+#define SPI_DMA_REQUEST     1
+
+#define SPI_TX_QUEUE_MASK   (SPI_TX_QUEUE_SIZE - 1)
+
+typedef struct {
+    uint32_t tag;
+    uint32_t done_us;
+    uint8_t  len;
+    uint8_t  tx[SPI_TX_MAX_LEN];
+    uint8_t  rx[SPI_TX_MAX_LEN];
+} spi_tx_slot_t;
+
+static spi_tx_slot_t g_spi_tx_ring[SPI_TX_QUEUE_SIZE];
+
+// Free-running indices, tail <= done <= head:
+//   [tail, done) finished, waiting for take_done (main loop advances tail)
+//   [done, head) queued, slot done is on the wire  (ISR advances done)
+static volatile uint8_t  g_spi_tx_head = 0;
+static volatile uint8_t  g_spi_tx_done = 0;
+static volatile uint8_t  g_spi_tx_tail = 0;
+static volatile uint8_t  g_spi_tx_busy = 0;
+
+static volatile uint32_t g_spi_tx_full_count = 0;
+
+// Point both channels at slot idx and start clocking it out
+static void spi_tx_start(uint8_t idx) {
+    spi_tx_slot_t *slot = &g_spi_tx_ring[idx & SPI_TX_QUEUE_MASK];
+
+    SPI_DMA_RX->CCR  &= ~DMA_CCR_EN;
+    SPI_DMA_TX->CCR  &= ~DMA_CCR_EN;
+    SPI_DMA_RX->CMAR  = (uint32_t) slot->rx;
+    SPI_DMA_TX->CMAR  = (uint32_t) slot->tx;
+    SPI_DMA_RX->CNDTR = slot->len;
+    SPI_DMA_TX->CNDTR = slot->len;
+
+    enable_cs();
+
+    // RX first so no received byte can be missed
+    SPI_DMA_RX->CCR |= DMA_CCR_EN;
+    SPI_DMA_TX->CCR |= DMA_CCR_EN;
+}
+
+void spi_tx_queue_init(void) {
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+
+    DMA1_CSELR->CSELR &= ~(DMA_CSELR_C2S | DMA_CSELR_C3S);
+    DMA1_CSELR->CSELR |= (SPI_DMA_REQUEST << DMA_CSELR_C2S_Pos) |
+                         (SPI_DMA_REQUEST << DMA_CSELR_C3S_Pos);
+
+    // RX: SPI1->DR -> memory, 8-bit, interrupt on complete / error
+    SPI_DMA_RX->CCR  = 0;
+    SPI_DMA_RX->CPAR = (uint32_t) &SPI1->DR;
+    SPI_DMA_RX->CCR  = DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE;
+
+    // TX: memory -> SPI1->DR, 8-bit, no interrupts (RX tells us when done)
+    SPI_DMA_TX->CCR  = 0;
+    SPI_DMA_TX->CPAR = (uint32_t) &SPI1->DR;
+    SPI_DMA_TX->CCR  = DMA_CCR_MINC | DMA_CCR_DIR;
+
+    // Drain anything left in the RX FIFO, then hand both directions to DMA
+    while (SPI1->SR & SPI_SR_RXNE) {
+        (void) *(volatile uint8_t *) &SPI1->DR;
+    }
+    SPI1->CR2 |= SPI_CR2_RXDMAEN;
+    SPI1->CR2 |= SPI_CR2_TXDMAEN;
+
+    NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+}
+
+uint8_t spi_tx_queue_push(const uint8_t *tx, uint8_t len, uint32_t tag) {
+    uint8_t head = g_spi_tx_head;
+
+    if (len == 0 || len > SPI_TX_MAX_LEN) {
+        return 0;
+    }
+    if ((uint8_t)(head - g_spi_tx_tail) >= SPI_TX_QUEUE_SIZE) {
+        g_spi_tx_full_count++;
+        return 0;
+    }
+
+    spi_tx_slot_t *slot = &g_spi_tx_ring[head & SPI_TX_QUEUE_MASK];
+    for (uint8_t i = 0; i < len; i++) {
+        slot->tx[i] = tx[i];
+    }
+    slot->len = len;
+    slot->tag = tag;
+
+    // Publish the slot, then kick the DMA if it has gone idle. If the ISR
+    // completes between these two steps it sees the new head and starts
+    // the slot itself, leaving busy set.
+    __DMB();
+    g_spi_tx_head = head + 1;
+
+    if (!g_spi_tx_busy) {
+        g_spi_tx_busy = 1;
+        spi_tx_start(head);
+    }
+    return 1;
+}
+
+uint8_t spi_tx_queue_take_done(spi_tx_done_t *done) {
+    uint8_t tail = g_spi_tx_tail;
+
+    if (tail == g_spi_tx_done) {
+        return 0;
+    }
+    __DMB();
+
+    const spi_tx_slot_t *slot = &g_spi_tx_ring[tail & SPI_TX_QUEUE_MASK];
+    done->tag     = slot->tag;
+    done->done_us = slot->done_us;
+    done->len     = slot->len;
+    for (uint8_t i = 0; i < slot->len; i++) {
+        done->rx[i] = slot->rx[i];
+    }
+
+    // Finish reading the slot before handing it back to push()
+    __DMB();
+    g_spi_tx_tail = tail + 1;
+    return 1;
+}
+
+uint32_t spi_tx_queue_get_full_count(void) {
+    return g_spi_tx_full_count;
+}
+
+void DMA1_Channel2_IRQHandler(void) {
+    uint32_t isr = DMA1->ISR;
+    if (!(isr & (DMA_ISR_TCIF2 | DMA_ISR_TEIF2))) {
+        return;
+    }
+    DMA1->IFCR = DMA_IFCR_CGIF2;
+
+    // Every byte has been clocked in, so the bus is idle: end the transfer
+    disable_cs();
+
+    uint8_t done = g_spi_tx_done;
+    g_spi_tx_ring[done & SPI_TX_QUEUE_MASK].done_us = timebase_now_us();
+
+    __DMB();
+    g_spi_tx_done = ++done;
+
+    if (done != g_spi_tx_head) {
+        spi_tx_start(done);
+    } else {
+        g_spi_tx_busy = 0;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef SPI_TX_QUEUE_H
+#define SPI_TX_QUEUE_H
+
+#include <stdint.h>
+
+/*
+ * spi_tx_queue.h
+ * Non-blocking SPI1 transmit queue driven by DMA.
+ *
+ * spi_tx_queue_push() copies a transfer into a ring and returns at once.
+ * Transfers run back to back on DMA1 channel 3 (SPI1_TX) with channel 2
+ * (SPI1_RX) capturing what the FPGA shifts back. The RX transfer-complete
+ * interrupt, which fires only after the last bit has been clocked, drops
+ * chip-enable, timestamps the transfer and starts the next one.
+ *
+ * Finished transfers stay in the ring until the main loop collects them
+ * with spi_tx_queue_take_done(), so completion handling (latency
+ * bookkeeping, received bytes) runs in main-loop context.
+ *
+ * Single producer: only call push / take_done from the main loop.
+ */
+
+#define SPI_TX_QUEUE_SIZE     8    // power of two, divides 256
+#define SPI_TX_MAX_LEN        24   // longest transfer, >= SPI_TRANSFER_MAX_LEN
+
+// One finished transfer
+typedef struct {
+    uint32_t tag;       // value given to spi_tx_queue_push()
+    uint32_t done_us;   // timebase_now_us() when chip-enable dropped
+    uint8_t  len;
+    uint8_t  rx[SPI_TX_MAX_LEN];  // bytes received while sending
+} spi_tx_done_t;
+
+/**
+ * Route SPI1 TX/RX to DMA1 channels 3/2 and enable the completion
+ * interrupt. initSPI() must run first.
+ */
+void spi_tx_queue_init(void);
+
+/**
+ * Queue len bytes (1..SPI_TX_MAX_LEN) to send under one chip-enable.
+ * tag is returned with the transfer by spi_tx_queue_take_done().
+ * Returns 0 if the queue is full or len is out of range.
+ */
+uint8_t spi_tx_queue_push(const uint8_t *tx, uint8_t len, uint32_t tag);
+
+/**
+ * Copy out the oldest finished transfer and free its slot.
+ * Returns 0 if none has finished since the last call.
+ */
+uint8_t spi_tx_queue_take_done(spi_tx_done_t *done);
+
+/**
+ * Transfers refused by spi_tx_queue_push() because the queue was full.
+ */
+uint32_t spi_tx_queue_get_full_count(void);
+
+/**
+ * SPI1_RX DMA transfer complete: end of one queued transfer.
+ * (Name must match the vector table.)
+ */
+void DMA1_Channel2_IRQHandler(void);
+
+#endif // SPI_TX_QUEUE_H
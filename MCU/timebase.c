@@ -0,0 +1,19 @@
+/*
+ * timebase.c
+ * 1 MHz free-running TIM2 counter used for input-latency timestamps.
+ */
+
+#include <stdint.h>
+
+#include "stm32l4xx.h"
+#include "timebase.h"
+
+void timebase_init(void) {
+    TIM2->CR1  = 0;
+    TIM2->PSC  = (uint32_t)(SystemCoreClock / 1000000U) - 1;
+    TIM2->ARR  = 0xFFFFFFFFU;   // TIM2 is 32 bits wide, use all of it
+    TIM2->CNT  = 0;
+    TIM2->EGR |= TIM_EGR_UG;    // load prescaler
+    TIM2->SR  &= ~TIM_SR_UIF;
+    TIM2->CR1 |= TIM_CR1_CEN;
+}
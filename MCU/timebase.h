@@ -0,0 +1,31 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+#include "stm32l4xx.h"
+
+/*
+ * timebase.h
+ * Free-running 32-bit microsecond counter on TIM2.
+ *
+ * TIM2 counts at 1 MHz and wraps every ~71.6 minutes; take differences
+ * with unsigned subtraction, (uint32_t)(later - earlier), and they stay
+ * correct across the wrap. Reading it is a single register load, so it is
+ * cheap enough to call from any ISR.
+ */
+
+/**
+ * Start TIM2 as a 1 MHz free-running counter.
+ * The TIM2 peripheral clock must already be enabled.
+ */
+void timebase_init(void);
+
+/**
+ * Current time in microseconds.
+ */
+static inline uint32_t timebase_now_us(void) {
+    return TIM2->CNT;
+}
+
+#endif // TIMEBASE_H
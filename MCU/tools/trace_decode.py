@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+
+"""
+trace_decode.py
+
+Host-side decoder for the binary trace log written by MCU/trace.c.
+
+Reads the raw byte stream (a capture file, or a serial port such as the
+board's USART2 virtual COM port) and prints one line per record:
+
+    [   1234.567890 ms] KEY_PRESS        key='<'
+
+Usage:
+  python3 trace_decode.py capture.bin
+  python3 trace_decode.py /dev/ttyACM0          (needs pyserial)
+  python3 trace_decode.py capture.bin --cpu-hz 80000000
+
+Record layout (little endian, see trace.h):
+  [0xA5][id][payload:4][timestamp:4][xor of the previous 10 bytes]
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC_BYTE = 0xA5
+RECORD_LEN = 11
+
+# Keep in sync with trace_event_t in trace.h
+EVENT_NAMES = {
+    1: "PS2_EVENT",
+    2: "KEY_PRESS",
+    3: "KEY_RELEASE",
+    4: "REPEAT_FIRE",
+    5: "SPI_FRAME",
+    6: "PS2_OVERFLOW",
+    7: "DROPPED",
+    8: "LATENCY",
+    9: "SPI_FULL",
+}
+
+# Keep in sync with latency_stage_t / latency_stat_t in latency.h
+LATENCY_STAGES = ["rx->scan", "scan->spi", "rx->spi"]
+LATENCY_STATS = ["count", "min_us", "mean_us", "p99_us", "max_us"]
+
+
+def key_repr(code):
+    ch = chr(code)
+    return repr(ch) if ch.isprintable() else f"0x{code:02X}"
+
+
+def format_payload(name, payload):
+    if name == "PS2_EVENT":
+        flags = payload >> 8
+        kind = ("E0 " if flags & 1 else "") + ("break" if flags & 2 else "make")
+        return f"code=0x{payload & 0xFF:02X} {kind}"
+    if name in ("KEY_PRESS", "KEY_RELEASE"):
+        return f"key={key_repr(payload & 0xFF)}"
+    if name == "REPEAT_FIRE":
+        return f"slot={payload & 0xFF} command={(payload >> 8) & 0xFF}"
+    if name == "SPI_FRAME":
+        return (f"seq={payload & 0xFF} len={(payload >> 8) & 0xFF} "
+                f"crc=0x{(payload >> 16) & 0xFF:02X}")
+    if name == "LATENCY":
+        stage, stat = payload >> 28, (payload >> 24) & 0xF
+        stage = LATENCY_STAGES[stage] if stage < len(LATENCY_STAGES) else stage
+        stat = LATENCY_STATS[stat] if stat < len(LATENCY_STATS) else stat
+        return f"{stage:<10} {stat}={payload & 0xFFFFFF}"
+    if name in ("PS2_OVERFLOW", "DROPPED", "SPI_FULL"):
+        return f"total={payload}"
+    return f"payload=0x{payload:08X}"
+
+
+def records(stream):
+    """Yield (id, payload, timestamp), resyncing on bad checksums."""
+    buf = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        buf.extend(chunk)
+
+        while len(buf) >= RECORD_LEN:
+            if buf[0] != SYNC_BYTE:
+                del buf[0]
+                continue
+
+            check = 0
+            for b in buf[:RECORD_LEN - 1]:
+                check ^= b
+            if check != buf[RECORD_LEN - 1] or buf[1] not in EVENT_NAMES:
+                del buf[0]
+                continue
+
+            event_id, payload, timestamp = struct.unpack_from("<BII", buf, 1)
+            del buf[:RECORD_LEN]
+            yield event_id, payload, timestamp
+
+
+def open_input(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial, only needed for live capture
+        return serial.Serial(path, baud, timeout=None)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode MCU binary trace log")
+    parser.add_argument("input", help="capture file, serial port, or - for stdin")
+    parser.add_argument("--cpu-hz", type=float, default=80e6,
+                        help="DWT cycle counter frequency (SystemCoreClock)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    # Unwrap the 32-bit cycle counter. Records from a preempting ISR can be
+    # a few cycles out of order, so only a large backwards jump is a wrap.
+    last_ts = None
+    wraps = 0
+
+    for event_id, payload, timestamp in records(open_input(args.input, args.baud)):
+        if last_ts is not None and last_ts - timestamp > (1 << 31):
+            wraps += 1
+        last_ts = timestamp
+
+        ms = ((wraps << 32) + timestamp) * 1e3 / args.cpu_hz
+        name = EVENT_NAMES[event_id]
+        print(f"[{ms:14.6f} ms] {name:<16} {format_payload(name, payload)}", flush=True)
+
+
+if __name__ == "__main__":
+    main()
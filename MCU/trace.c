@@ -0,0 +1,153 @@
+/*
+ * trace.c
+ * Lock-free binary trace ring, drained to USART2 or RTT in idle time.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "stm32l4xx.h"
+#include "STM32L432KC_USART.h"
+#include "trace.h"
+
+/* ---------------- Ring storage ---------------- */
+
+// Must be a power of two
+#define TRACE_RING_BITS 6
+#define TRACE_RING_SIZE (1u << TRACE_RING_BITS)
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+
+typedef struct {
+    uint32_t         timestamp;
+    uint32_t         payload;
+    uint8_t          id;
+    volatile uint8_t lap;  // commit marker, see trace_lap()
+} trace_slot_t;
+
+static trace_slot_t g_trace_ring[TRACE_RING_SIZE];
+
+// Producers (any context) reserve slots by advancing head with LDREX/STREX;
+// only trace_drain() advances tail.
+static volatile uint32_t g_trace_head = 0;
+static volatile uint32_t g_trace_tail = 0;
+
+static volatile uint32_t g_trace_dropped          = 0;
+static uint32_t          g_trace_dropped_reported = 0;
+
+// Record currently being shifted out by trace_drain()
+static uint8_t g_trace_tx[TRACE_RECORD_LEN];
+static uint8_t g_trace_tx_len = 0;
+static uint8_t g_trace_tx_pos = 0;
+
+// Value a slot's lap field holds once index idx has been written into it.
+// Never 0 for the first lap, so zero-initialised slots read as empty.
+static inline uint8_t trace_lap(uint32_t idx) {
+    return (uint8_t)((idx >> TRACE_RING_BITS) + 1);
+}
+
+static void trace_atomic_inc(volatile uint32_t *p) {
+    uint32_t v;
+    do {
+        v = __LDREXW(p);
+    } while (__STREXW(v + 1, p));
+}
+
+// Store one record; returns 0 if the ring is full
+static uint8_t trace_put(trace_event_t id, uint32_t payload) {
+    uint32_t head;
+
+    // Reserve a slot
+    do {
+        head = __LDREXW(&g_trace_head);
+        if (head - g_trace_tail >= TRACE_RING_SIZE) {
+            __CLREX();
+            return 0;
+        }
+    } while (__STREXW(head + 1, &g_trace_head));
+
+    trace_slot_t *slot = &g_trace_ring[head & TRACE_RING_MASK];
+    slot->timestamp = DWT->CYCCNT;
+    slot->payload   = payload;
+    slot->id        = (uint8_t) id;
+
+    // Commit last, after the record body is visible
+    __DMB();
+    slot->lap = trace_lap(head);
+    return 1;
+}
+
+/* ---------------- Public API ---------------- */
+
+void trace_init(void) {
+    // Free-running core cycle counter for timestamps
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if TRACE_SINK == TRACE_SINK_USART2
+    initUSART(USART2_ID, 115200);
+#endif
+}
+
+void trace_log(trace_event_t id, uint32_t payload) {
+    if (!trace_put(id, payload)) {
+        trace_atomic_inc(&g_trace_dropped);
+    }
+}
+
+void trace_drain(void) {
+    // Report drops once, from idle time
+    uint32_t dropped = g_trace_dropped;
+    if (dropped != g_trace_dropped_reported && trace_put(TRACE_DROPPED, dropped)) {
+        g_trace_dropped_reported = dropped;
+    }
+
+    // Serialise the next committed record if the previous one is done
+    if (g_trace_tx_pos == g_trace_tx_len) {
+        uint32_t      tail = g_trace_tail;
+        trace_slot_t *slot = &g_trace_ring[tail & TRACE_RING_MASK];
+
+        // Reserved but not yet committed (or ring empty): try again later
+        if (tail == g_trace_head || slot->lap != trace_lap(tail)) {
+            return;
+        }
+        __DMB();
+
+        uint8_t *b = g_trace_tx;
+        b[0]  = TRACE_SYNC_BYTE;
+        b[1]  = slot->id;
+        b[2]  = (uint8_t)(slot->payload);
+        b[3]  = (uint8_t)(slot->payload >> 8);
+        b[4]  = (uint8_t)(slot->payload >> 16);
+        b[5]  = (uint8_t)(slot->payload >> 24);
+        b[6]  = (uint8_t)(slot->timestamp);
+        b[7]  = (uint8_t)(slot->timestamp >> 8);
+        b[8]  = (uint8_t)(slot->timestamp >> 16);
+        b[9]  = (uint8_t)(slot->timestamp >> 24);
+        b[10] = 0;
+        for (uint8_t i = 0; i < TRACE_RECORD_LEN - 1; i++) {
+            b[10] ^= b[i];
+        }
+        g_trace_tx_len = TRACE_RECORD_LEN;
+        g_trace_tx_pos = 0;
+
+        // Slot contents copied, hand it back to the producers
+        __DMB();
+        g_trace_tail = tail + 1;
+    }
+
+#if TRACE_SINK == TRACE_SINK_USART2
+    // Only feed the transmitter while it has room; never wait
+    while (g_trace_tx_pos < g_trace_tx_len && (USART2->ISR & USART_ISR_TXE)) {
+        USART2->TDR = g_trace_tx[g_trace_tx_pos++];
+    }
+#elif TRACE_SINK == TRACE_SINK_RTT
+    // RTT writes are a memcpy into the target-side buffer
+    if (g_trace_tx_pos < g_trace_tx_len) {
+        fwrite(g_trace_tx, 1, g_trace_tx_len, stdout);
+        g_trace_tx_pos = g_trace_tx_len;
+    }
+#else
+#error "Unknown TRACE_SINK"
+#endif
+}
@@ -0,0 +1,61 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/*
+ * trace.h
+ * Deferred binary trace log.
+ *
+ * trace_log() stores a fixed-size record (event id, DWT cycle timestamp,
+ * 32-bit payload) in a lock-free ring; it is safe from any ISR priority and
+ * from the main loop. trace_drain() ships finished records out of the ring
+ * from idle time, so nothing on the hot path ever waits on a slow link.
+ * tools/trace_decode.py turns the byte stream back into text.
+ *
+ * Wire format, one record (little endian):
+ *   [0xA5][id][payload:4][timestamp:4][xor of the previous 10 bytes]
+ */
+
+// Where trace_drain() sends records (select with -DTRACE_SINK=...)
+#define TRACE_SINK_USART2 1  // USART2 TX (PA2), 115200 8N1, the board's VCP
+#define TRACE_SINK_RTT    2  // stdout, i.e. RTT channel 0 with SES RTT I/O
+
+#ifndef TRACE_SINK
+#define TRACE_SINK TRACE_SINK_USART2
+#endif
+
+#define TRACE_SYNC_BYTE   0xA5
+#define TRACE_RECORD_LEN  11
+
+// Event ids; keep in sync with EVENT_NAMES in tools/trace_decode.py
+typedef enum {
+    TRACE_PS2_EVENT    = 1,  // payload: code | flags << 8
+    TRACE_KEY_PRESS    = 2,  // payload: key character
+    TRACE_KEY_RELEASE  = 3,  // payload: key character
+    TRACE_REPEAT_FIRE  = 4,  // payload: slot | command << 8
+    TRACE_SPI_FRAME    = 5,  // payload: seq | len << 8 | crc << 16
+    TRACE_PS2_OVERFLOW = 6,  // payload: total PS/2 events dropped
+    TRACE_DROPPED      = 7,  // payload: total trace records dropped
+    TRACE_LATENCY      = 8,  // payload: see latency_report()
+    TRACE_SPI_FULL     = 9,  // payload: total SPI frames refused
+} trace_event_t;
+
+/**
+ * Start the DWT cycle counter used for timestamps and bring up the sink.
+ */
+void trace_init(void);
+
+/**
+ * Append one record. Never blocks; if the ring is full the record is
+ * counted as dropped and reported by a later TRACE_DROPPED record.
+ */
+void trace_log(trace_event_t id, uint32_t payload);
+
+/**
+ * Send as many finished records as the sink accepts without waiting.
+ * Call from the main loop's idle time.
+ */
+void trace_drain(void);
+
+#endif // TRACE_H